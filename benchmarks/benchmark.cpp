@@ -1,16 +1,60 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <unistd.h>
 #include <bits/stdc++.h> 
 
 #include <list>
+#include <forward_list>
 #include <vector>
 #include "list.h"
+#include "forward_list.h"
 #include "vector.h"
+#include "typed_list.h"
+#include "typed_vector.h"
+#include "stdcontainers.hpp"
+#include "lru_cache.h"
+#include "concurrent_vector.h"
+#include "concurrent_list.h"
+#include "concurrent_lru_cache.h"
+#include "lockfree_stack.h"
+#include "work_stealing_deque.h"
+#include "epoch.h"
+#include "topk.h"
+#include "external_sort.h"
+#include "mapped_vector.h"
+#include "snapshot.h"
 
 #define BENCH_PUSH_BACK 10000000
 #define BENCH_ITERATE   40000000
 #define BENCH_SORT      1000000
+#define BENCH_SHUFFLED  4000000
+#define BENCH_CHURN     4000000
+#define CHURN_LISTS     16
+#define BENCH_LRU       10000000
+#define LRU_KEYS        1000000
+#define LRU_CAPACITY    65536
+#define BENCH_CONCURRENT 1000000
+#define CONCURRENT_BATCH 32
+#define CONCURRENT_MAX_THREADS 64
+#define FORK_JOIN_FIB    34
+#define FORK_JOIN_CUTOFF 16
+#define BENCH_EPOCH     10000000
+#define BENCH_EMPLACE   200000
+#define BENCH_FIFO      200000
+#define FIFO_LENGTH     4096
+#define BENCH_REMOVE    50000
+#define BENCH_ORDERED   10000
+#define ORDERED_WINDOW  16
+#define ORDERED_BASE    100000
+#define ORDERED_BATCH   1000
+#define DISTRIBUTION_RUN_COUNT 3
+#define BENCH_TOPK      10000000
+#define TOPK_K          100
+#define BENCH_EXTERNAL  8000000
+#define EXTERNAL_RUN_SIZE (2 << 20)
+#define BENCH_MAPPED    10000000
+#define BENCH_SNAPSHOT  4000000
 #define RUN_COUNT       10
 
 
@@ -35,6 +79,17 @@ int int_comparator(const void* a, const void* b)
     return *((int*)a) - *((int*)b);
 }
 
+/* typed comparator, inlined by the DECLARE_*_SORT macros */
+static inline int int_typed_comparator(const int* a, const int* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+DECLARE_VECTOR(int)
+DECLARE_VECTOR_SORT(int, sort, int_typed_comparator)
+DECLARE_LIST(int)
+DECLARE_LIST_SORT(int, sort, int_typed_comparator)
+
 /* C style comparator for a vector2f */
 int vector2f_comparator(const void* a, const void* b)
 {
@@ -55,6 +110,44 @@ struct stl_vector2f_comparator
     }
 };
 
+/* relink the nodes of a list in random order so that walking it jumps all over the heap */
+void shuffle_list_nodes(list_t* list)
+{
+    std::vector<node_t*> nodes;
+    node_t* previous = NULL;
+
+    for(node_t* node = list->begin; node != NULL; node = node->next){
+        nodes.push_back(node);
+    }
+    std::shuffle(nodes.begin(), nodes.end(), std::mt19937(rand()));
+
+    for(size_t i=0; i<nodes.size(); i++){
+        nodes[i]->previous = previous;
+        nodes[i]->next = NULL;
+        if(previous){
+            previous->next = nodes[i];
+        }
+        previous = nodes[i];
+    }
+    list->begin = nodes.front();
+    list->end = nodes.back();
+}
+
+/* same as above, std::list style */
+void shuffle_stl_list_nodes(std::list<int>& list)
+{
+    std::vector<std::list<int>::iterator> nodes;
+
+    for(std::list<int>::iterator it = list.begin(); it != list.end(); ++it){
+        nodes.push_back(it);
+    }
+    std::shuffle(nodes.begin(), nodes.end(), std::mt19937(rand()));
+
+    for(size_t i=0; i<nodes.size(); i++){
+        list.splice(list.end(), list, nodes[i]);
+    }
+}
+
 double stdcontainers_list_push_back_benchmark()
 {
     clock_t start;
@@ -200,6 +293,45 @@ double stdcontainers_list_iterate_benchmark()
 
 }
 
+double stdcontainers_list_cursor_iterate_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    list_t list;
+    list_cursor_t cursor;
+    void* batch[LIST_CURSOR_BATCH_SIZE];
+    int count;
+    int value;
+
+    list_create(&list, sizeof(int));
+
+    escape(&list);
+    escape(&value);
+
+    /* populate list first */
+    for(int i=0; i<BENCH_ITERATE;i++){
+        list_push_back(&list, &i);
+    }
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        list_cursor_init(&cursor, &list);
+        while((count = list_cursor_next(&cursor, batch, LIST_CURSOR_BATCH_SIZE)) > 0){
+            for(int i=0; i<count; i++){
+                value = *((int*)batch[i]);
+            }
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    list_destroy(&list);
+
+    time /= (double)RUN_COUNT;
+    return time;
+
+}
+
 double stl_list_iterate_benchmark()
 {
     clock_t start;
@@ -304,247 +436,195 @@ double stl_list_sort_benchmark()
 }
 
 
-double stdcontainers_list_sort_v2f_benchmark()
+double stdcontainers_forward_list_push_back_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    list_t list;
-    vector2f v;
+    forward_list_t list;
 
-    list_create(&list, sizeof(vector2f));
-    list_set_comparator(&list, &vector2f_comparator);
+    forward_list_create(&list, sizeof(int));
 
     escape(&list);
-    escape(&v);
 
     for(int j=0;j<RUN_COUNT;j++){
-
-        for(int i=0; i<BENCH_SORT;i++){
-            v.x = (rand() % 1000) / 1000.0f;
-            v.y = (rand() % 1000) / 1000.0f;
-            list_push_back(&list, &v);
-        }
-
+        forward_list_clear(&list);
         start = clock();
-        list_sort(&list);
+        for(int i=0; i<BENCH_PUSH_BACK;i++){
+            forward_list_push_back(&list, &i);
+        }
         end = clock();
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
-
-        list_clear(&list);
     }
-
-    list_destroy(&list);
+    forward_list_destroy(&list);
 
     time /= (double)RUN_COUNT;
     return time;
 }
 
-double stl_list_sort_v2f_benchmark()
+double stl_forward_list_push_back_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    std::list<vector2f> list;
-    vector2f v;
+    std::forward_list<int> list;
 
     escape(&list);
-    escape(&v);
-
-    /* populate list first */
 
+    /* std::forward_list has no push_back: insert after an iterator kept on the last element */
     for(int j=0;j<RUN_COUNT;j++){
-
-        for(int i=0; i<BENCH_SORT;i++){
-            v.x = (rand() % 1000) / 1000.0f;
-            v.y = (rand() % 1000) / 1000.0f;
-            list.push_back(v);
-        }
-
-        start = clock();
-        list.sort(stl_vector2f_comparator());
-        end = clock();
-        time += ((double) (end - start)) / CLOCKS_PER_SEC;
-
         list.clear();
-    }
-
-    time /= (double)RUN_COUNT;
-    return time;
-}
-
-double stdcontainers_vector_push_back_benchmark()
-{
-    clock_t start;
-    clock_t end;
-    double time = 0;
-    vector_t vector;
-
-    vector_create(&vector, sizeof(int));
-
-    escape(&vector);
-    escape(&vector.data);
-
-    for(int j=0;j<RUN_COUNT;j++){
-        vector_clear(&vector);
         start = clock();
+        std::forward_list<int>::iterator last = list.before_begin();
         for(int i=0; i<BENCH_PUSH_BACK;i++){
-            vector_push_back(&vector, &i);
+            last = list.insert_after(last, i);
         }
         end = clock();
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
     }
-    vector_destroy(&vector);
-    
-    time /= (double)RUN_COUNT;
+    list.clear();
 
+    time /= (double)RUN_COUNT;
     return time;
 }
 
-double stl_vector_push_back_benchmark()
+double stdcontainers_forward_list_iterate_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    std::vector<int> vector;
+    forward_list_t list;
+    int value;
 
-    escape(&vector);
+    forward_list_create(&list, sizeof(int));
+
+    escape(&list);
+    escape(&value);
 
+    for(int i=0; i<BENCH_ITERATE;i++){
+        forward_list_push_back(&list, &i);
+    }
 
     for(int j=0;j<RUN_COUNT;j++){
-        vector.clear();
         start = clock();
-        for(int i=0; i<BENCH_PUSH_BACK;i++){
-            vector.push_back(i);
+        for(forward_node_t* node = list.begin; node != NULL; node = node->next){
+            value = *((int*)node->data);
         }
         end = clock();
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
     }
-    vector.clear();
+    forward_list_destroy(&list);
 
     time /= (double)RUN_COUNT;
     return time;
 }
 
-double stdcontainers_vector_iterate_benchmark()
+double stl_forward_list_iterate_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    vector_t vector;
+    std::forward_list<int> list;
     int value;
 
-    vector_create(&vector, sizeof(int));
-
-    escape(&vector);
-    escape(&vector.data);
+    escape(&list);
     escape(&value);
 
-
+    std::forward_list<int>::iterator last = list.before_begin();
     for(int i=0; i<BENCH_ITERATE;i++){
-        vector_push_back(&vector, &i);
+        last = list.insert_after(last, i);
     }
 
     for(int j=0;j<RUN_COUNT;j++){
-
         start = clock();
-        int* data = (int*)vector_front(&vector);
-        for(int i=0; i< (int)vector.size; ++i){
-            value = data[i];
+        for(std::forward_list<int>::iterator it = list.begin(); it != list.end(); ++it){
+            value = *it;
         }
         end = clock();
-
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
     }
 
-    vector_destroy(&vector);
-    time /= (double)RUN_COUNT;
+    list.clear();
 
+    time /= (double)RUN_COUNT;
     return time;
 }
 
-double stl_vector_iterate_benchmark()
+double stdcontainers_forward_list_sort_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    std::vector<int> vector;
+    forward_list_t list;
     int value;
 
+    forward_list_create(&list, sizeof(int));
+    forward_list_set_comparator(&list, &int_comparator);
 
-    escape(&vector);
+    escape(&list);
     escape(&value);
 
+    for(int j=0;j<RUN_COUNT;j++){
 
-    /* populate list first */
-    for(int i=0; i<BENCH_ITERATE;i++){
-        vector.push_back(i);
-    }
+        for(int i=0; i<BENCH_SORT;i++){
+            value = rand();
+            forward_list_push_back(&list, &value);
+        }
 
-    for(int j=0;j<RUN_COUNT;j++){
         start = clock();
-        std::vector<int>::iterator it;
-        for (it = vector.begin(); it != vector.end(); ++it){
-            value = *it;
-        }
+        forward_list_sort(&list);
         end = clock();
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        forward_list_clear(&list);
     }
 
-    vector.clear();
+    forward_list_destroy(&list);
 
     time /= (double)RUN_COUNT;
     return time;
 }
 
-double stdcontainers_vector_sort_benchmark()
+double stl_forward_list_sort_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    vector_t vector;
-    int value;
+    std::forward_list<int> list;
 
-
-    vector_create(&vector, sizeof(int));
-
-    escape(&vector);
-    escape(&vector.data);
+    escape(&list);
 
     for(int j=0;j<RUN_COUNT;j++){
 
         for(int i=0; i<BENCH_SORT;i++){
-            value = rand();
-            vector_push_back(&vector, &value);
+            list.push_front(rand());
         }
 
         start = clock();
-        vector_sort(&vector, &int_comparator);
+        list.sort();
         end = clock();
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
 
-        vector_clear(&vector);
+        list.clear();
     }
 
-    vector_destroy(&vector);
-
     time /= (double)RUN_COUNT;
     return time;
 }
 
-double stdcontainers_vector_sort_v2f_benchmark()
+
+double stdcontainers_list_sort_v2f_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    vector_t vector;
+    list_t list;
     vector2f v;
 
+    list_create(&list, sizeof(vector2f));
+    list_set_comparator(&list, &vector2f_comparator);
 
-    vector_create(&vector, sizeof(int));
-
-    escape(&vector);
-    escape(&vector.data);
+    escape(&list);
     escape(&v);
 
     for(int j=0;j<RUN_COUNT;j++){
@@ -552,105 +632,2443 @@ double stdcontainers_vector_sort_v2f_benchmark()
         for(int i=0; i<BENCH_SORT;i++){
             v.x = (rand() % 1000) / 1000.0f;
             v.y = (rand() % 1000) / 1000.0f;
-            vector_push_back(&vector, &v);
+            list_push_back(&list, &v);
         }
 
         start = clock();
-        vector_sort(&vector, &vector2f_comparator);
+        list_sort(&list);
         end = clock();
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
 
-        vector_clear(&vector);
+        list_clear(&list);
     }
 
-    vector_destroy(&vector);
+    list_destroy(&list);
 
     time /= (double)RUN_COUNT;
     return time;
 }
 
-double stl_vector_sort_benchmark()
+double stl_list_sort_v2f_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    std::vector<int> vector;
-    int value;
+    std::list<vector2f> list;
+    vector2f v;
 
-    escape(&vector);
+    escape(&list);
+    escape(&v);
+
+    /* populate list first */
 
     for(int j=0;j<RUN_COUNT;j++){
 
         for(int i=0; i<BENCH_SORT;i++){
-            value = rand();
-            vector.push_back(value);
+            v.x = (rand() % 1000) / 1000.0f;
+            v.y = (rand() % 1000) / 1000.0f;
+            list.push_back(v);
         }
 
         start = clock();
-        sort(vector.begin(), vector.end());
+        list.sort(stl_vector2f_comparator());
         end = clock();
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
 
-        vector.clear();
+        list.clear();
     }
 
     time /= (double)RUN_COUNT;
     return time;
 }
 
-
-double stl_vector_sort_v2f_benchmark()
+double stdcontainers_list_iterate_shuffled_benchmark()
 {
     clock_t start;
     clock_t end;
     double time = 0;
-    std::vector<vector2f> vector;
-    vector2f v;
+    list_t list;
+    int value;
 
-    escape(&vector);
-    escape(&v);
+    list_create(&list, sizeof(int));
 
-    for(int j=0;j<RUN_COUNT;j++){
+    escape(&list);
+    escape(&value);
 
-        for(int i=0; i<BENCH_SORT;i++){
-            v.x = (rand() % 1000) / 1000.0f;
-            v.y = (rand() % 1000) / 1000.0f;
-            vector.push_back(v);
-        }
+    for(int i=0; i<BENCH_SHUFFLED;i++){
+        list_push_back(&list, &i);
+    }
+    shuffle_list_nodes(&list);
 
+    for(int j=0;j<RUN_COUNT;j++){
         start = clock();
-        sort(vector.begin(), vector.end(), stl_vector2f_comparator());
+        for(node_t* node = list.begin; node != NULL; node = node->next){
+            value = *((int*)node->data);
+        }
         end = clock();
         time += ((double) (end - start)) / CLOCKS_PER_SEC;
-
-        vector.clear();
     }
+    list_destroy(&list);
 
     time /= (double)RUN_COUNT;
     return time;
 }
 
-
-int main()
+double stl_list_iterate_shuffled_benchmark()
 {
-    srand(time(0));
-
-    printf("stdcontainers C library vs C++ STL benchmark\n");
-
-
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::list<int> list;
+    int value;
+
+    escape(&list);
+    escape(&value);
+
+    for(int i=0; i<BENCH_SHUFFLED;i++){
+        list.push_back(i);
+    }
+    shuffle_stl_list_nodes(list);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        std::list<int>::iterator it;
+        for (it = list.begin(); it != list.end(); ++it){
+            value = *it;
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    list.clear();
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdcontainers_list_contains_shuffled_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    list_t list;
+    int value = -1;
+    bool found = false;
+
+    list_create(&list, sizeof(int));
+    list_set_comparator(&list, &int_comparator);
+
+    escape(&list);
+    escape(&found);
+
+    for(int i=0; i<BENCH_SHUFFLED;i++){
+        list_push_back(&list, &i);
+    }
+    shuffle_list_nodes(&list);
+
+    /* value is never found: the whole list is walked */
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        found = list_contains(&list, &value);
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    list_destroy(&list);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stl_list_find_shuffled_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::list<int> list;
+    bool found = false;
+
+    escape(&list);
+    escape(&found);
+
+    for(int i=0; i<BENCH_SHUFFLED;i++){
+        list.push_back(i);
+    }
+    shuffle_stl_list_nodes(list);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        found = std::find(list.begin(), list.end(), -1) != list.end();
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    list.clear();
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdcontainers_list_clear_shuffled_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    list_t list;
+
+    list_create(&list, sizeof(int));
+
+    escape(&list);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        for(int i=0; i<BENCH_SHUFFLED;i++){
+            list_push_back(&list, &i);
+        }
+        shuffle_list_nodes(&list);
+
+        start = clock();
+        list_clear(&list);
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    list_destroy(&list);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stl_list_clear_shuffled_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::list<int> list;
+
+    escape(&list);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        for(int i=0; i<BENCH_SHUFFLED;i++){
+            list.push_back(i);
+        }
+        shuffle_stl_list_nodes(list);
+
+        start = clock();
+        list.clear();
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdcontainers_list_iterate_time(list_t* list)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    int value;
+
+    escape(&value);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        for(node_t* node = list->begin; node != NULL; node = node->next){
+            value = *((int*)node->data);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    return time / (double)RUN_COUNT;
+}
+
+/* percentage of links whose next node starts at most one cache line further (adjacent) or anywhere further (forward) */
+void stdcontainers_list_locality(list_t* list, double* adjacent, double* forward)
+{
+    size_t links = 0;
+    size_t near = 0;
+    size_t ahead = 0;
+
+    for(node_t* node = list->begin; node != NULL && node->next != NULL; node = node->next){
+        intptr_t delta = (intptr_t)node->next - (intptr_t)node;
+        links++;
+        if(delta > 0) ahead++;
+        if(delta > 0 && delta <= 64) near++;
+    }
+
+    *adjacent = links ? 100.0 * (double)near / (double)links : 100.0;
+    *forward = links ? 100.0 * (double)ahead / (double)links : 100.0;
+}
+
+/* CHURN_LISTS lists exchange elements at random, leaving their nodes scattered all over the heap */
+void stdcontainers_list_churn_benchmark(double* fresh, double* churned, double* compact, double* compacted, double locality[4])
+{
+    clock_t start;
+    clock_t end;
+    list_t lists[CHURN_LISTS];
+    int value;
+
+    for(int k=0; k<CHURN_LISTS; k++){
+        list_create(&lists[k], sizeof(int));
+    }
+    for(int i=0; i<BENCH_CHURN; i++){
+        list_push_back(&lists[i % CHURN_LISTS], &i);
+    }
+
+    *fresh = stdcontainers_list_iterate_time(&lists[0]);
+
+    for(int i=0; i<BENCH_CHURN * 4; i++){
+        if(list_pop_front(&lists[rand() % CHURN_LISTS], &value) == 0){
+            list_push_back(&lists[rand() % CHURN_LISTS], &value);
+        }
+    }
+
+    *churned = stdcontainers_list_iterate_time(&lists[0]);
+    stdcontainers_list_locality(&lists[0], &locality[0], &locality[1]);
+
+    start = clock();
+    list_compact(&lists[0]);
+    end = clock();
+    *compact = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+    *compacted = stdcontainers_list_iterate_time(&lists[0]);
+    stdcontainers_list_locality(&lists[0], &locality[2], &locality[3]);
+
+    for(int k=0; k<CHURN_LISTS; k++){
+        list_destroy(&lists[k]);
+    }
+}
+
+/* a record too large to be built in a temporary for free */
+typedef struct record256{
+    uint32_t id;
+    uint8_t payload[252];
+}record256;
+
+static inline void fill_record(record256* record, int i)
+{
+    record->id = (uint32_t)i;
+    memset(record->payload, (uint8_t)i, sizeof(record->payload));
+}
+
+/* push_back of a temporary record when emplace is false, in place construction otherwise */
+double stdcontainers_vector_record_benchmark(bool emplace)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_t vector;
+    record256 record;
+
+    vector_create(&vector, sizeof(record256));
+
+    escape(&vector);
+    escape(&record);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        vector_clear(&vector);
+        start = clock();
+        for(int i=0; i<BENCH_EMPLACE;i++){
+            if(emplace){
+                fill_record((record256*)vector_emplace_back(&vector), i);
+            }
+            else{
+                fill_record(&record, i);
+                vector_push_back(&vector, &record);
+            }
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    vector_destroy(&vector);
+
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+double stdcontainers_list_record_benchmark(bool emplace)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    list_t list;
+    record256 record;
+
+    list_create(&list, sizeof(record256));
+
+    escape(&list);
+    escape(&record);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        for(int i=0; i<BENCH_EMPLACE;i++){
+            if(emplace){
+                fill_record((record256*)list_emplace_back(&list), i);
+            }
+            else{
+                fill_record(&record, i);
+                list_push_back(&list, &record);
+            }
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+        list_clear(&list);
+    }
+    list_destroy(&list);
+
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+double stl_vector_record_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<record256> vector;
+
+    for(int j=0;j<RUN_COUNT;j++){
+        vector.clear();
+        start = clock();
+        for(int i=0; i<BENCH_EMPLACE;i++){
+            vector.emplace_back();
+            fill_record(&vector.back(), i);
+        }
+        end = clock();
+        escape(vector.data());
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+/* pop_front as vector.c used to do it: shift the whole array left */
+static inline void shifting_pop_front(vector_t* vector, void* data)
+{
+    memcpy(data, vector->data, vector->size_type);
+    memmove(vector->data, vector->data + vector->size_type, (vector->size - 1) * vector->size_type);
+    vector_pop_back(vector, NULL);
+}
+
+/*
+ * vector_t as a FIFO. batch: FIFO_LENGTH elements are pushed then drained, until BENCH_FIFO pops.
+ * steady: the queue holds FIFO_LENGTH elements and every push_back is followed by a pop_front.
+ */
+double vector_fifo_benchmark(bool shifting, bool steady)
+{
+    clock_t start;
+    clock_t end;
+    vector_t vector;
+    long sum = 0;
+    int value;
+
+    vector_create(&vector, sizeof(int));
+    escape(&vector);
+
+    if(steady){
+        for(int i=0; i<FIFO_LENGTH; i++){
+            vector_push_back(&vector, &i);
+        }
+    }
+
+    start = clock();
+    for(int i=0; i<BENCH_FIFO; ){
+        int count = steady ? 1 : FIFO_LENGTH;
+        for(int j=0; j<count; j++){
+            vector_push_back(&vector, &i);
+        }
+        for(int j=0; j<count; j++, i++){
+            if(shifting){
+                shifting_pop_front(&vector, &value);
+            }
+            else{
+                vector_pop_front(&vector, &value);
+            }
+            sum += value;
+        }
+    }
+    end = clock();
+    escape(&sum);
+    vector_destroy(&vector);
+
+    return ((double) (end - start)) / CLOCKS_PER_SEC;
+}
+
+double stl_deque_fifo_benchmark(bool steady)
+{
+    clock_t start;
+    clock_t end;
+    std::deque<int> deque;
+    long sum = 0;
+
+    if(steady){
+        for(int i=0; i<FIFO_LENGTH; i++){
+            deque.push_back(i);
+        }
+    }
+
+    start = clock();
+    for(int i=0; i<BENCH_FIFO; ){
+        int count = steady ? 1 : FIFO_LENGTH;
+        for(int j=0; j<count; j++){
+            deque.push_back(i);
+        }
+        for(int j=0; j<count; j++, i++){
+            sum += deque.front();
+            deque.pop_front();
+        }
+    }
+    end = clock();
+    escape(&sum);
+
+    return ((double) (end - start)) / CLOCKS_PER_SEC;
+}
+
+int is_odd_predicate(const void* data, void* ctx)
+{
+    (void)ctx;
+    return *(const int*)data & 1;
+}
+
+/* drop the odd values out of BENCH_REMOVE random integers, with vector_remove_if or one vector_erase per match */
+double vector_remove_if_benchmark(bool erase_loop)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_t vector;
+
+    vector_create(&vector, sizeof(int));
+    escape(&vector);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        vector_clear(&vector);
+        for(int i=0; i<BENCH_REMOVE; i++){
+            int value = rand();
+            vector_push_back(&vector, &value);
+        }
+        start = clock();
+        if(erase_loop){
+            for(int i=0; i<(int)vector.size; ){
+                if(*(int*)vector_at(&vector, i) & 1){
+                    vector_erase(&vector, i);
+                }
+                else{
+                    i++;
+                }
+            }
+        }
+        else{
+            vector_remove_if(&vector, &is_odd_predicate, NULL);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    vector_destroy(&vector);
+
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+/* purge the odd values out of BENCH_SORT random integers, with list_remove_if or one list_erase_node per match */
+double list_remove_if_benchmark(bool erase_loop)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    list_t list;
+
+    list_create(&list, sizeof(int));
+    escape(&list);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        for(int i=0; i<BENCH_SORT; i++){
+            int value = rand();
+            list_push_back(&list, &value);
+        }
+        start = clock();
+        if(erase_loop){
+            node_t* next;
+            for(node_t* node = list.begin; node != NULL; node = next){
+                next = node->next;
+                if(*(int*)node->data & 1){
+                    list_erase_node(&list, node);
+                }
+            }
+        }
+        else{
+            list_remove_if(&list, &is_odd_predicate, NULL, NULL);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+        list_clear(&list);
+    }
+    list_destroy(&list);
+
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+double stl_list_remove_if_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::list<int> list;
+
+    for(int j=0;j<RUN_COUNT;j++){
+        for(int i=0; i<BENCH_SORT; i++){
+            list.push_back(rand());
+        }
+        start = clock();
+        list.remove_if([](int value){ return (value & 1) != 0; });
+        end = clock();
+        escape(&list);
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+        list.clear();
+    }
+
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+double stl_vector_remove_if_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<int> vector;
+
+    for(int j=0;j<RUN_COUNT;j++){
+        vector.clear();
+        for(int i=0; i<BENCH_REMOVE; i++){
+            vector.push_back(rand());
+        }
+        start = clock();
+        vector.erase(std::remove_if(vector.begin(), vector.end(), [](int value){ return (value & 1) != 0; }), vector.end());
+        end = clock();
+        escape(vector.data());
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+enum sort_distribution { SORT_RANDOM, SORT_SORTED, SORT_REVERSED, SORT_NEARLY_SORTED, SORT_FEW_UNIQUE, SORT_DISTRIBUTIONS };
+static const char* sort_distribution_names[SORT_DISTRIBUTIONS] = { "random", "sorted", "reversed", "nearly sorted", "few unique" };
+
+enum sort_path { SORT_VECTOR, SORT_VECTOR_STABLE, SORT_VECTOR_TYPED, SORT_LIST, SORT_STL, SORT_STL_STABLE };
+
+/* BENCH_SORT integers. nearly sorted: 1% of the elements are swapped with a random one. few unique: 16 distinct values */
+void fill_sort_distribution(std::vector<int>& values, int distribution)
+{
+    values.resize(BENCH_SORT);
+    for(int i=0; i<BENCH_SORT; i++){
+        switch(distribution){
+            case SORT_SORTED: case SORT_NEARLY_SORTED: values[i] = i; break;
+            case SORT_REVERSED: values[i] = BENCH_SORT - i; break;
+            case SORT_FEW_UNIQUE: values[i] = rand() % 16; break;
+            default: values[i] = rand(); break;
+        }
+    }
+    if(distribution == SORT_NEARLY_SORTED){
+        for(int i=0; i<BENCH_SORT / 100; i++){
+            std::swap(values[rand() % BENCH_SORT], values[rand() % BENCH_SORT]);
+        }
+    }
+}
+
+/* time to sort BENCH_SORT integers of the given distribution through one of the sort paths */
+double sort_distribution_benchmark(int path, int distribution)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<int> values;
+    vector_t scratch;
+
+    vector_create(&scratch, sizeof(int));
+
+    for(int j=0;j<DISTRIBUTION_RUN_COUNT;j++){
+        fill_sort_distribution(values, distribution);
+
+        if(path == SORT_VECTOR || path == SORT_VECTOR_STABLE){
+            vector_t vector;
+            vector_create_with(&vector, sizeof(int), values.size());
+            memcpy(vector.data, values.data(), values.size() * sizeof(int));
+            vector.size = values.size();
+            start = clock();
+            if(path == SORT_VECTOR){
+                vector_sort(&vector, &int_comparator);
+            }
+            else{
+                vector_stable_sort_with(&vector, &int_comparator, &scratch);
+            }
+            end = clock();
+            escape(vector.data);
+            vector_destroy(&vector);
+        }
+        else if(path == SORT_VECTOR_TYPED){
+            vector_int_t vector;
+            vector_int_create_with(&vector, values.size());
+            memcpy(vector.data, values.data(), values.size() * sizeof(int));
+            vector.size = values.size();
+            start = clock();
+            vector_int_sort(&vector);
+            end = clock();
+            escape(vector.data);
+            vector_int_destroy(&vector);
+        }
+        else if(path == SORT_LIST){
+            list_t list;
+            list_create(&list, sizeof(int));
+            list_set_comparator(&list, &int_comparator);
+            for(int value : values){
+                list_push_back(&list, &value);
+            }
+            start = clock();
+            list_sort(&list);
+            end = clock();
+            escape(&list);
+            list_destroy(&list);
+        }
+        else{
+            start = clock();
+            if(path == SORT_STL){
+                std::sort(values.begin(), values.end());
+            }
+            else{
+                std::stable_sort(values.begin(), values.end());
+            }
+            end = clock();
+            escape(values.data());
+        }
+
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    vector_destroy(&scratch);
+
+    time /= (double)DISTRIBUTION_RUN_COUNT;
+    return time;
+}
+
+enum topk_path { TOPK_VECTOR_SORT, TOPK_VECTOR_PARTIAL_SORT, TOPK_VECTOR_NTH_ELEMENT, TOPK_ACCUMULATOR, TOPK_STL_SORT, TOPK_STL_PARTIAL_SORT, TOPK_STL_NTH_ELEMENT };
+
+/* time to bring the TOPK_K smallest of BENCH_TOPK random integers to the front of the buffer */
+double topk_benchmark(int path, const std::vector<int>& values)
+{
+    clock_t start;
+    clock_t end;
+
+    if(path == TOPK_ACCUMULATOR){
+        topk_t topk;
+        vector_t best;
+        topk_create(&topk, sizeof(int), TOPK_K, &int_comparator);
+        vector_create(&best, sizeof(int));
+        start = clock();
+        topk_push_n(&topk, values.data(), values.size());
+        topk_extract(&topk, &best);
+        end = clock();
+        escape(best.data);
+        vector_destroy(&best);
+        topk_destroy(&topk);
+    }
+    else if(path == TOPK_VECTOR_SORT || path == TOPK_VECTOR_PARTIAL_SORT || path == TOPK_VECTOR_NTH_ELEMENT){
+        vector_t vector;
+        vector_create_with(&vector, sizeof(int), values.size());
+        memcpy(vector.data, values.data(), values.size() * sizeof(int));
+        vector.size = values.size();
+        start = clock();
+        if(path == TOPK_VECTOR_SORT){
+            vector_sort(&vector, &int_comparator);
+        }
+        else if(path == TOPK_VECTOR_PARTIAL_SORT){
+            vector_partial_sort(&vector, TOPK_K, &int_comparator);
+        }
+        else{
+            vector_nth_element(&vector, TOPK_K, &int_comparator);
+        }
+        end = clock();
+        escape(vector.data);
+        vector_destroy(&vector);
+    }
+    else{
+        std::vector<int> copy(values);
+        start = clock();
+        if(path == TOPK_STL_SORT){
+            std::sort(copy.begin(), copy.end());
+        }
+        else if(path == TOPK_STL_PARTIAL_SORT){
+            std::partial_sort(copy.begin(), copy.begin() + TOPK_K, copy.end());
+        }
+        else{
+            std::nth_element(copy.begin(), copy.begin() + TOPK_K, copy.end());
+        }
+        end = clock();
+        escape(copy.data());
+    }
+
+    return ((double) (end - start)) / CLOCKS_PER_SEC;
+}
+
+/* sort BENCH_EXTERNAL random integers from a file to another through runs of EXTERNAL_RUN_SIZE bytes.
+The input is written beforehand, so both files are mostly served from the page cache */
+double external_sort_benchmark(bool overlap)
+{
+    external_sort_config_t config;
+    std::vector<int> values(BENCH_EXTERNAL);
+    FILE* in = tmpfile();
+    FILE* out = tmpfile();
+
+    for(int i=0; i<BENCH_EXTERNAL; i++){
+        values[i] = rand();
+    }
+    fwrite(values.data(), sizeof(int), values.size(), in);
+    fflush(in);
+    rewind(in);
+
+    external_sort_config_init(&config, sizeof(int));
+    config.run_size = EXTERNAL_RUN_SIZE;
+    config.overlap = overlap ? 1 : 0;
+
+    auto start = std::chrono::steady_clock::now();
+    external_sort(fileno(in), fileno(out), &int_comparator, &config);
+    auto end = std::chrono::steady_clock::now();
+
+    fclose(in);
+    fclose(out);
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/* the same integers sorted in memory with vector_sort, for reference */
+double external_sort_in_memory_benchmark()
+{
+    vector_t vector;
+
+    vector_create_with(&vector, sizeof(int), BENCH_EXTERNAL);
+    for(int i=0; i<BENCH_EXTERNAL; i++){
+        int value = rand();
+        vector_push_back(&vector, &value);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    vector_sort(&vector, &int_comparator);
+    auto end = std::chrono::steady_clock::now();
+    escape(vector.data);
+    vector_destroy(&vector);
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+enum mapped_step { MAPPED_CREATE, MAPPED_REOPEN, MAPPED_READ, MAPPED_SHRINK, MAPPED_STEPS };
+
+/* one round trip through a mapped_vector backed by a temporary file: create it with the minimum capacity
+and grow it to BENCH_MAPPED integers, close it and reopen it, read it back, then drop half of the
+elements, shrink the file and reopen it again. Returns false if an element did not survive a reopen */
+bool mapped_vector_benchmark(double times[MAPPED_STEPS])
+{
+    char path[] = "/tmp/mapped_vector_XXXXXX";
+    mapped_vector_t table;
+    long long sum = 0;
+    long long expected = 0;
+    bool ok = true;
+    int fd = mkstemp(path);
+
+    if(fd < 0) return false;
+    close(fd);
+
+    auto start = std::chrono::steady_clock::now();
+    ok = ok && mapped_vector_open_with(&table, path, sizeof(int), 0) == 0;
+    for(int i=0; ok && i<BENCH_MAPPED; i++){
+        ok = mapped_vector_push_back(&table, &i) == 0;
+        expected += i;
+    }
+    mapped_vector_close(&table);
+    auto end = std::chrono::steady_clock::now();
+    times[MAPPED_CREATE] = std::chrono::duration<double>(end - start).count();
+
+    start = std::chrono::steady_clock::now();
+    ok = ok && mapped_vector_open(&table, path, sizeof(int)) == 0;
+    end = std::chrono::steady_clock::now();
+    times[MAPPED_REOPEN] = std::chrono::duration<double>(end - start).count();
+
+    start = std::chrono::steady_clock::now();
+    ok = ok && mapped_vector_size(&table) == (size_t)BENCH_MAPPED;
+    for(size_t i=0; ok && i<mapped_vector_size(&table); i++){
+        sum += *(int*)mapped_vector_at(&table, i);
+    }
+    end = std::chrono::steady_clock::now();
+    times[MAPPED_READ] = std::chrono::duration<double>(end - start).count();
+    ok = ok && sum == expected;
+
+    start = std::chrono::steady_clock::now();
+    for(int i=0; ok && i<BENCH_MAPPED / 2; i++){
+        ok = mapped_vector_pop_back(&table, NULL) == 0;
+    }
+    ok = ok && mapped_vector_shrink_to_fit(&table) == 0;
+    mapped_vector_close(&table);
+    ok = ok && mapped_vector_open(&table, path, sizeof(int)) == 0;
+    end = std::chrono::steady_clock::now();
+    times[MAPPED_SHRINK] = std::chrono::duration<double>(end - start).count();
+
+    ok = ok && mapped_vector_size(&table) == (size_t)BENCH_MAPPED / 2 && table.header->capacity == (uint64_t)BENCH_MAPPED / 2;
+    ok = ok && *(int*)mapped_vector_back(&table) == BENCH_MAPPED / 2 - 1;
+    if(table.header){
+        mapped_vector_close(&table);
+    }
+    unlink(path);
+
+    return ok;
+}
+
+static const char* snapshot_kind_names[] = { "", "vector_t", "list_t", "forward_list_t" };
+
+/* save BENCH_SNAPSHOT integers to a temporary file and load them back into a new container of the same kind.
+Returns false if the loaded container does not hold the saved elements in the same order */
+bool snapshot_benchmark(snapshot_kind_t container, double* save, double* load)
+{
+    FILE* file = tmpfile();
+    int fd = fileno(file);
+    vector_t vector, vector_loaded;
+    list_t list, list_loaded;
+    forward_list_t forward_list, forward_list_loaded;
+    bool ok = true;
+    int i = 0;
+
+    vector_create_with(&vector, sizeof(int), BENCH_SNAPSHOT);
+    list_create(&list, sizeof(int));
+    forward_list_create(&forward_list, sizeof(int));
+    for(int k=0; k<BENCH_SNAPSHOT; k++){
+        if(container == SNAPSHOT_VECTOR) vector_push_back(&vector, &k);
+        else if(container == SNAPSHOT_LIST) list_push_back(&list, &k);
+        else forward_list_push_back(&forward_list, &k);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if(container == SNAPSHOT_VECTOR) ok = vector_save(&vector, fd) == 0;
+    else if(container == SNAPSHOT_LIST) ok = list_save(&list, fd) == 0;
+    else ok = forward_list_save(&forward_list, fd) == 0;
+    auto end = std::chrono::steady_clock::now();
+    *save = std::chrono::duration<double>(end - start).count();
+
+    lseek(fd, 0, SEEK_SET);
+
+    start = std::chrono::steady_clock::now();
+    if(container == SNAPSHOT_VECTOR){
+        ok = ok && vector_load(&vector_loaded, fd) == 0;
+    }
+    else if(container == SNAPSHOT_LIST){
+        ok = ok && list_load(&list_loaded, fd) == 0;
+    }
+    else{
+        ok = ok && forward_list_load(&forward_list_loaded, fd) == 0;
+    }
+    end = std::chrono::steady_clock::now();
+    *load = std::chrono::duration<double>(end - start).count();
+
+    if(ok && container == SNAPSHOT_VECTOR){
+        ok = vector_loaded.size == (size_t)BENCH_SNAPSHOT;
+        for(i=0; ok && i<BENCH_SNAPSHOT; i++){
+            ok = *(int*)vector_at(&vector_loaded, i) == i;
+        }
+        vector_destroy(&vector_loaded);
+    }
+    else if(ok && container == SNAPSHOT_LIST){
+        ok = list_loaded.size == BENCH_SNAPSHOT;
+        for(node_t* node = list_loaded.begin; ok && node != NULL; node = node->next, i++){
+            ok = *(int*)node->data == i && (node->next == NULL ? list_loaded.end == node : node->next->previous == node);
+        }
+        ok = ok && i == BENCH_SNAPSHOT;
+        list_destroy(&list_loaded);
+    }
+    else if(ok){
+        ok = forward_list_loaded.size == BENCH_SNAPSHOT;
+        for(forward_node_t* node = forward_list_loaded.begin; ok && node != NULL; node = node->next, i++){
+            ok = *(int*)node->data == i && (node->next != NULL || forward_list_loaded.end == node);
+        }
+        ok = ok && i == BENCH_SNAPSHOT;
+        forward_list_destroy(&forward_list_loaded);
+    }
+
+    vector_destroy(&vector);
+    list_destroy(&list);
+    forward_list_destroy(&forward_list);
+    fclose(file);
+
+    return ok;
+}
+
+/* feed snapshots whose header lies about the content: an element count whose byte size wraps around,
+one beyond the int sizes of the containers, and a valid header followed by a truncated payload.
+Returns true if every load is rejected */
+bool snapshot_reject_benchmark()
+{
+    snapshot_header_t headers[3];
+    vector_t vector;
+    list_t list;
+    forward_list_t forward_list;
+    bool ok = true;
+
+    memset(headers, 0x00, sizeof(headers));
+    for(int h=0; h<3; h++){
+        headers[h].magic = SNAPSHOT_MAGIC;
+        headers[h].version = SNAPSHOT_VERSION;
+        headers[h].size_type = sizeof(uint64_t);
+    }
+    headers[0].size = 1ULL << 61;
+    headers[1].size = (uint64_t)INT_MAX + 1;
+    headers[2].size = 16;
+
+    for(int h=0; h<3; h++){
+        for(int kind=SNAPSHOT_VECTOR; kind<=SNAPSHOT_FORWARD_LIST; kind++){
+            FILE* file = tmpfile();
+            int fd = fileno(file);
+            uint64_t payload[4] = {0};
+
+            headers[h].kind = (uint16_t)kind;
+            fwrite(&headers[h], sizeof(snapshot_header_t), 1, file);
+            fwrite(payload, sizeof(payload), 1, file);
+            fflush(file);
+            lseek(fd, 0, SEEK_SET);
+
+            if(kind == SNAPSHOT_VECTOR) ok = ok && vector_load(&vector, fd) == -1;
+            else if(kind == SNAPSHOT_LIST) ok = ok && list_load(&list, fd) == -1;
+            else ok = ok && forward_list_load(&forward_list, fd) == -1;
+
+            fclose(file);
+        }
+    }
+
+    return ok;
+}
+
+enum ordered_stream { ORDERED_SORTED, ORDERED_RANDOM, ORDERED_LOCALLY_SHUFFLED, ORDERED_STREAMS };
+static const char* ordered_stream_names[ORDERED_STREAMS] = { "sorted", "random", "local shuffle" };
+
+/* BENCH_ORDERED increasing integers, shuffled completely or within windows of ORDERED_WINDOW elements */
+void fill_ordered_stream(std::vector<int>& values, int stream)
+{
+    std::mt19937 rng(rand());
+
+    values.resize(BENCH_ORDERED);
+    for(int i=0; i<BENCH_ORDERED; i++){
+        values[i] = i;
+    }
+    if(stream == ORDERED_RANDOM){
+        std::shuffle(values.begin(), values.end(), rng);
+    }
+    else if(stream == ORDERED_LOCALLY_SHUFFLED){
+        for(int i=0; i + ORDERED_WINDOW <= BENCH_ORDERED; i+=ORDERED_WINDOW){
+            std::shuffle(values.begin() + i, values.begin() + i + ORDERED_WINDOW, rng);
+        }
+    }
+}
+
+/* time to build a sorted list out of a stream with list_add_ordered or forward_list_add_ordered */
+double add_ordered_benchmark(bool forward, bool finger, int stream)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<int> values;
+
+    for(int j=0;j<DISTRIBUTION_RUN_COUNT;j++){
+        fill_ordered_stream(values, stream);
+
+        if(forward){
+            forward_list_t list;
+            forward_list_create(&list, sizeof(int));
+            forward_list_set_comparator(&list, &int_comparator);
+            forward_list_set_finger(&list, finger);
+            start = clock();
+            for(int value : values){
+                forward_list_add_ordered(&list, &value);
+            }
+            end = clock();
+            escape(&list);
+            forward_list_destroy(&list);
+        }
+        else{
+            list_t list;
+            list_create(&list, sizeof(int));
+            list_set_comparator(&list, &int_comparator);
+            list_set_finger(&list, finger);
+            start = clock();
+            for(int value : values){
+                list_add_ordered(&list, &value);
+            }
+            end = clock();
+            escape(&list);
+            list_destroy(&list);
+        }
+
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)DISTRIBUTION_RUN_COUNT;
+    return time;
+}
+
+/* time to add ORDERED_BATCH random integers to a sorted list of ORDERED_BASE integers,
+one list_add_ordered at a time or with a single list_add_ordered_n */
+double add_ordered_batch_benchmark(bool batch)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<int> values(ORDERED_BATCH);
+    list_t list;
+
+    list_create(&list, sizeof(int));
+    list_set_comparator(&list, &int_comparator);
+
+    for(int j=0;j<DISTRIBUTION_RUN_COUNT;j++){
+        for(int i=0; i<ORDERED_BASE; i++){
+            list_push_back(&list, &i);
+        }
+        for(int i=0; i<ORDERED_BATCH; i++){
+            values[i] = rand() % ORDERED_BASE;
+        }
+
+        start = clock();
+        if(batch){
+            list_add_ordered_n(&list, values.data(), ORDERED_BATCH);
+        }
+        else{
+            for(int value : values){
+                list_add_ordered(&list, &value);
+            }
+        }
+        end = clock();
+        escape(&list);
+        list_clear(&list);
+
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    list_destroy(&list);
+
+    time /= (double)DISTRIBUTION_RUN_COUNT;
+    return time;
+}
+
+/* the std::list way: sort the batch in a list of its own, then merge */
+double stl_list_merge_batch_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<int> values(ORDERED_BATCH);
+    std::list<int> list;
+
+    for(int j=0;j<DISTRIBUTION_RUN_COUNT;j++){
+        for(int i=0; i<ORDERED_BASE; i++){
+            list.push_back(i);
+        }
+        for(int i=0; i<ORDERED_BATCH; i++){
+            values[i] = rand() % ORDERED_BASE;
+        }
+
+        start = clock();
+        std::list<int> other(values.begin(), values.end());
+        other.sort();
+        list.merge(other);
+        end = clock();
+        escape(&list);
+        list.clear();
+
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)DISTRIBUTION_RUN_COUNT;
+    return time;
+}
+
+double stdcontainers_vector_push_back_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_t vector;
+
+    vector_create(&vector, sizeof(int));
+
+    escape(&vector);
+    escape(&vector.data);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        vector_clear(&vector);
+        start = clock();
+        for(int i=0; i<BENCH_PUSH_BACK;i++){
+            vector_push_back(&vector, &i);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    vector_destroy(&vector);
+    
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+double stl_vector_push_back_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<int> vector;
+
+    escape(&vector);
+
+
+    for(int j=0;j<RUN_COUNT;j++){
+        vector.clear();
+        start = clock();
+        for(int i=0; i<BENCH_PUSH_BACK;i++){
+            vector.push_back(i);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    vector.clear();
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdcontainers_vector_iterate_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_t vector;
+    int value;
+
+    vector_create(&vector, sizeof(int));
+
+    escape(&vector);
+    escape(&vector.data);
+    escape(&value);
+
+
+    for(int i=0; i<BENCH_ITERATE;i++){
+        vector_push_back(&vector, &i);
+    }
+
+    for(int j=0;j<RUN_COUNT;j++){
+
+        start = clock();
+        int* data = (int*)vector_front(&vector);
+        for(int i=0; i< (int)vector.size; ++i){
+            value = data[i];
+        }
+        end = clock();
+
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    vector_destroy(&vector);
+    time /= (double)RUN_COUNT;
+
+    return time;
+}
+
+double stl_vector_iterate_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<int> vector;
+    int value;
+
+
+    escape(&vector);
+    escape(&value);
+
+
+    /* populate list first */
+    for(int i=0; i<BENCH_ITERATE;i++){
+        vector.push_back(i);
+    }
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        std::vector<int>::iterator it;
+        for (it = vector.begin(); it != vector.end(); ++it){
+            value = *it;
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    vector.clear();
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdcontainers_vector_sort_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_t vector;
+    int value;
+
+
+    vector_create(&vector, sizeof(int));
+
+    escape(&vector);
+    escape(&vector.data);
+
+    for(int j=0;j<RUN_COUNT;j++){
+
+        for(int i=0; i<BENCH_SORT;i++){
+            value = rand();
+            vector_push_back(&vector, &value);
+        }
+
+        start = clock();
+        vector_sort(&vector, &int_comparator);
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        vector_clear(&vector);
+    }
+
+    vector_destroy(&vector);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdcontainers_vector_sort_v2f_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_t vector;
+    vector2f v;
+
+
+    vector_create(&vector, sizeof(int));
+
+    escape(&vector);
+    escape(&vector.data);
+    escape(&v);
+
+    for(int j=0;j<RUN_COUNT;j++){
+
+        for(int i=0; i<BENCH_SORT;i++){
+            v.x = (rand() % 1000) / 1000.0f;
+            v.y = (rand() % 1000) / 1000.0f;
+            vector_push_back(&vector, &v);
+        }
+
+        start = clock();
+        vector_sort(&vector, &vector2f_comparator);
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        vector_clear(&vector);
+    }
+
+    vector_destroy(&vector);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stl_vector_sort_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<int> vector;
+    int value;
+
+    escape(&vector);
+
+    for(int j=0;j<RUN_COUNT;j++){
+
+        for(int i=0; i<BENCH_SORT;i++){
+            value = rand();
+            vector.push_back(value);
+        }
+
+        start = clock();
+        sort(vector.begin(), vector.end());
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        vector.clear();
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+
+double stl_vector_sort_v2f_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    std::vector<vector2f> vector;
+    vector2f v;
+
+    escape(&vector);
+    escape(&v);
+
+    for(int j=0;j<RUN_COUNT;j++){
+
+        for(int i=0; i<BENCH_SORT;i++){
+            v.x = (rand() % 1000) / 1000.0f;
+            v.y = (rand() % 1000) / 1000.0f;
+            vector.push_back(v);
+        }
+
+        start = clock();
+        sort(vector.begin(), vector.end(), stl_vector2f_comparator());
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        vector.clear();
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+
+double typed_vector_push_back_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_int_t vector;
+
+    vector_int_create(&vector);
+
+    escape(&vector);
+    escape(&vector.data);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        vector_int_clear(&vector);
+        start = clock();
+        for(int i=0; i<BENCH_PUSH_BACK;i++){
+            vector_int_push_back(&vector, i);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    vector_int_destroy(&vector);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double typed_vector_iterate_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_int_t vector;
+    int value;
+
+    vector_int_create(&vector);
+
+    escape(&vector);
+    escape(&vector.data);
+    escape(&value);
+
+    for(int i=0; i<BENCH_ITERATE;i++){
+        vector_int_push_back(&vector, i);
+    }
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        for(size_t i=0; i<vector.size; ++i){
+            value = *vector_int_at(&vector, i);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    vector_int_destroy(&vector);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double typed_vector_sort_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    vector_int_t vector;
+
+    vector_int_create(&vector);
+
+    escape(&vector);
+    escape(&vector.data);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        for(int i=0; i<BENCH_SORT;i++){
+            vector_int_push_back(&vector, rand());
+        }
+
+        start = clock();
+        vector_int_sort(&vector);
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        vector_int_clear(&vector);
+    }
+    vector_int_destroy(&vector);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double typed_list_push_back_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    list_int_t list;
+
+    list_int_create(&list);
+
+    escape(&list);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        list_int_clear(&list);
+        start = clock();
+        for(int i=0; i<BENCH_PUSH_BACK;i++){
+            list_int_push_back(&list, i);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    list_int_destroy(&list);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double typed_list_iterate_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    list_int_t list;
+    int value;
+
+    list_int_create(&list);
+
+    escape(&list);
+    escape(&value);
+
+    for(int i=0; i<BENCH_ITERATE;i++){
+        list_int_push_back(&list, i);
+    }
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        for(list_int_node_t* node = list.begin; node != NULL; node = node->next){
+            value = node->data;
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    list_int_destroy(&list);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double typed_list_sort_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    list_int_t list;
+
+    list_int_create(&list);
+
+    escape(&list);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        for(int i=0; i<BENCH_SORT;i++){
+            list_int_push_back(&list, rand());
+        }
+
+        start = clock();
+        list_int_sort(&list);
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        list_int_clear(&list);
+    }
+    list_int_destroy(&list);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdc_vector_push_back_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    stdc::vector<int> vector;
+
+    escape(&vector);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        vector.clear();
+        start = clock();
+        for(int i=0; i<BENCH_PUSH_BACK;i++){
+            vector.push_back(i);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdc_vector_iterate_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    stdc::vector<int> vector;
+    int value;
+
+    escape(&vector);
+    escape(&value);
+
+    for(int i=0; i<BENCH_ITERATE;i++){
+        vector.push_back(i);
+    }
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        for(int v : vector){
+            value = v;
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdc_vector_sort_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    stdc::vector<int> vector;
+
+    escape(&vector);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        for(int i=0; i<BENCH_SORT;i++){
+            vector.push_back(rand());
+        }
+
+        start = clock();
+        std::sort(vector.begin(), vector.end());
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        vector.clear();
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdc_list_push_back_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    stdc::list<int> list;
+
+    escape(&list);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        list.clear();
+        start = clock();
+        for(int i=0; i<BENCH_PUSH_BACK;i++){
+            list.push_back(i);
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+double stdc_list_iterate_benchmark()
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    stdc::list<int> list;
+    int value;
+
+    escape(&list);
+    escape(&value);
+
+    for(int i=0; i<BENCH_ITERATE;i++){
+        list.push_back(i);
+    }
+
+    for(int j=0;j<RUN_COUNT;j++){
+        start = clock();
+        for(int v : list){
+            value = v;
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+
+/* BENCH_LRU keys among LRU_KEYS following a Zipf distribution of exponent s: a few keys are very hot, most are cold */
+std::vector<uint64_t> zipf_keys(double s)
+{
+    std::vector<double> cdf(LRU_KEYS);
+    std::vector<uint64_t> keys(BENCH_LRU);
+    std::mt19937 rng(rand());
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double sum = 0;
+
+    for(int i=0; i<LRU_KEYS; i++){
+        sum += 1.0 / pow((double)(i + 1), s);
+        cdf[i] = sum;
+    }
+    for(int i=0; i<BENCH_LRU; i++){
+        size_t rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng) * sum) - cdf.begin();
+        /* scatter hot keys over the key space */
+        keys[i] = (uint64_t)rank * 2654435761u;
+    }
+
+    return keys;
+}
+
+/* read-through cache: a miss inserts the key */
+double stdcontainers_lru_cache_benchmark(const std::vector<uint64_t>& keys, double* hit_rate)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    lru_cache_t cache;
+    uint64_t* value = NULL;
+
+    escape(&value);
+
+    lru_cache_create(&cache, sizeof(uint64_t), sizeof(uint64_t), LRU_CAPACITY);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        lru_cache_clear(&cache);
+        lru_cache_reset_stats(&cache);
+        start = clock();
+        for(size_t i=0; i<keys.size(); i++){
+            value = (uint64_t*)lru_cache_get(&cache, &keys[i]);
+            if(!value){
+                lru_cache_put(&cache, &keys[i], &keys[i]);
+            }
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+    *hit_rate = (double)cache.hits / (double)(cache.hits + cache.misses);
+    lru_cache_destroy(&cache);
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+/* the usual std::list + std::unordered_map LRU */
+double stl_lru_cache_benchmark(const std::vector<uint64_t>& keys)
+{
+    clock_t start;
+    clock_t end;
+    double time = 0;
+    typedef std::list<std::pair<uint64_t, uint64_t> > lru_list;
+    lru_list list;
+    std::unordered_map<uint64_t, lru_list::iterator> index;
+    uint64_t value = 0;
+
+    escape(&value);
+
+    for(int j=0;j<RUN_COUNT;j++){
+        list.clear();
+        index.clear();
+        index.reserve(LRU_CAPACITY);
+        start = clock();
+        for(size_t i=0; i<keys.size(); i++){
+            auto it = index.find(keys[i]);
+            if(it != index.end()){
+                list.splice(list.begin(), list, it->second);
+                value = it->second->second;
+            }
+            else{
+                if(list.size() == LRU_CAPACITY){
+                    index.erase(list.back().first);
+                    list.pop_back();
+                }
+                list.emplace_front(keys[i], keys[i]);
+                index[keys[i]] = list.begin();
+            }
+        }
+        end = clock();
+        time += ((double) (end - start)) / CLOCKS_PER_SEC;
+    }
+
+    time /= (double)RUN_COUNT;
+    return time;
+}
+
+/* wall clock time for threads threads to each run body(thread index, BENCH_CONCURRENT / threads) */
+template <typename F>
+double run_threads(int threads, F body)
+{
+    std::vector<std::thread> workers;
+    std::atomic<bool> go(false);
+    int ops = BENCH_CONCURRENT / threads;
+
+    for(int t=0; t<threads; t++){
+        workers.emplace_back([&go, &body, t, ops](){
+            while(!go.load(std::memory_order_acquire)){
+                std::this_thread::yield();
+            }
+            body(t, ops);
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for(auto& worker : workers){
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/* 99% reads, 1% writes */
+double concurrent_vector_benchmark(int threads)
+{
+    concurrent_vector_t vector;
+
+    concurrent_vector_create_with(&vector, sizeof(int), 1024);
+    for(int i=0; i<1024; i++){
+        concurrent_vector_push_back(&vector, &i);
+    }
+
+    double time = run_threads(threads, [&vector](int t, int ops){
+        int value = 0;
+        escape(&value);
+        for(int i=0; i<ops; i++){
+            if(i % 100 == 0){
+                concurrent_vector_assign(&vector, (size_t)((i + t) & 1023), &i);
+            }
+            else{
+                concurrent_vector_at(&vector, (size_t)((i + t) & 1023), &value);
+            }
+        }
+    });
+
+    concurrent_vector_destroy(&vector);
+    return time;
+}
+
+double mutex_vector_benchmark(int threads)
+{
+    vector_t vector;
+    std::mutex lock;
+
+    vector_create_with(&vector, sizeof(int), 1024);
+    for(int i=0; i<1024; i++){
+        vector_push_back(&vector, &i);
+    }
+
+    double time = run_threads(threads, [&vector, &lock](int t, int ops){
+        int value = 0;
+        escape(&value);
+        for(int i=0; i<ops; i++){
+            std::lock_guard<std::mutex> guard(lock);
+            if(i % 100 == 0){
+                vector_assign(&vector, (i + t) & 1023, &i);
+            }
+            else{
+                value = *((int*)vector_at(&vector, (i + t) & 1023));
+            }
+        }
+    });
+
+    vector_destroy(&vector);
+    return time;
+}
+
+/* every thread pushes then pops CONCURRENT_BATCH elements at a time */
+double concurrent_list_benchmark(int threads)
+{
+    concurrent_list_t list;
+
+    concurrent_list_create(&list, sizeof(int));
+
+    double time = run_threads(threads, [&list](int t, int ops){
+        int batch[CONCURRENT_BATCH];
+        for(int k=0; k<CONCURRENT_BATCH; k++){
+            batch[k] = t;
+        }
+        for(int i=0; i<ops; i+=CONCURRENT_BATCH){
+            concurrent_list_push_back_n(&list, batch, CONCURRENT_BATCH);
+            concurrent_list_pop_front_n(&list, batch, CONCURRENT_BATCH);
+        }
+    });
+
+    concurrent_list_destroy(&list);
+    return time;
+}
+
+double mutex_list_benchmark(int threads)
+{
+    list_t list;
+    std::mutex lock;
+
+    list_create(&list, sizeof(int));
+
+    double time = run_threads(threads, [&list, &lock](int t, int ops){
+        int value = t;
+        for(int i=0; i<ops; i+=CONCURRENT_BATCH){
+            for(int k=0; k<CONCURRENT_BATCH; k++){
+                std::lock_guard<std::mutex> guard(lock);
+                list_push_back(&list, &value);
+            }
+            for(int k=0; k<CONCURRENT_BATCH; k++){
+                std::lock_guard<std::mutex> guard(lock);
+                list_pop_front(&list, &value);
+            }
+        }
+    });
+
+    list_destroy(&list);
+    return time;
+}
+
+/* read-through cache shared by all threads, each thread reading its own slice of the zipf keys */
+double concurrent_lru_cache_benchmark(int threads, const std::vector<uint64_t>& keys)
+{
+    concurrent_lru_cache_t cache;
+
+    concurrent_lru_cache_create(&cache, sizeof(uint64_t), sizeof(uint64_t), LRU_CAPACITY, CONCURRENT_MAX_THREADS);
+
+    double time = run_threads(threads, [&cache, &keys](int t, int ops){
+        uint64_t value;
+        const uint64_t* key = &keys[(size_t)t * ops];
+        for(int i=0; i<ops; i++){
+            if(concurrent_lru_cache_get(&cache, &key[i], &value) != 0){
+                concurrent_lru_cache_put(&cache, &key[i], &key[i]);
+            }
+        }
+    });
+
+    concurrent_lru_cache_destroy(&cache);
+    return time;
+}
+
+double mutex_lru_cache_benchmark(int threads, const std::vector<uint64_t>& keys)
+{
+    lru_cache_t cache;
+    std::mutex lock;
+
+    lru_cache_create(&cache, sizeof(uint64_t), sizeof(uint64_t), LRU_CAPACITY);
+
+    double time = run_threads(threads, [&cache, &lock, &keys](int t, int ops){
+        uint64_t value = 0;
+        const uint64_t* key = &keys[(size_t)t * ops];
+        escape(&value);
+        for(int i=0; i<ops; i++){
+            std::lock_guard<std::mutex> guard(lock);
+            uint64_t* cached = (uint64_t*)lru_cache_get(&cache, &key[i]);
+            if(cached){
+                value = *cached;
+            }
+            else{
+                lru_cache_put(&cache, &key[i], &key[i]);
+            }
+        }
+    });
+
+    lru_cache_destroy(&cache);
+    return time;
+}
+
+/* every thread pushes then pops CONCURRENT_BATCH elements at a time, one by one */
+double lockfree_stack_benchmark(int threads, size_t elimination_slots)
+{
+    lockfree_stack_t stack;
+
+    lockfree_stack_create_with(&stack, sizeof(int), CONCURRENT_MAX_THREADS * CONCURRENT_BATCH, elimination_slots);
+
+    double time = run_threads(threads, [&stack](int t, int ops){
+        int value = t;
+        for(int i=0; i<ops; i+=CONCURRENT_BATCH){
+            for(int k=0; k<CONCURRENT_BATCH; k++){
+                lockfree_stack_push(&stack, &value);
+            }
+            for(int k=0; k<CONCURRENT_BATCH; k++){
+                lockfree_stack_pop(&stack, &value);
+            }
+        }
+    });
+
+    lockfree_stack_destroy(&stack);
+    return time;
+}
+
+/* stack.h maps stack_push and stack_pop onto vector_push_back and vector_pop_back. Its stack_t
+ * clashes with signal.h's in C++, so the vector functions are called directly */
+double mutex_stack_benchmark(int threads)
+{
+    vector_t stack;
+    std::mutex lock;
+
+    vector_create_with(&stack, sizeof(int), CONCURRENT_MAX_THREADS * CONCURRENT_BATCH);
+
+    double time = run_threads(threads, [&stack, &lock](int t, int ops){
+        int value = t;
+        for(int i=0; i<ops; i+=CONCURRENT_BATCH){
+            for(int k=0; k<CONCURRENT_BATCH; k++){
+                std::lock_guard<std::mutex> guard(lock);
+                vector_push_back(&stack, &value);
+            }
+            for(int k=0; k<CONCURRENT_BATCH; k++){
+                std::lock_guard<std::mutex> guard(lock);
+                vector_pop_back(&stack, &value);
+            }
+        }
+    });
+
+    vector_destroy(&stack);
+    return time;
+}
+
+/* fork/join fib on a pool of threads, each owning a work_stealing_deque_t of task pointers */
+struct fork_join_task {
+    int n;
+    long result;
+    std::atomic<bool> done;
+};
+
+struct fork_join_pool {
+    std::vector<work_stealing_deque_t> deques;
+    std::atomic<bool> stop;
+};
+
+static thread_local int fork_join_worker;
+
+long fib_sequential(int n)
+{
+    return n < 2 ? n : fib_sequential(n - 1) + fib_sequential(n - 2);
+}
+
+fork_join_task* fork_join_find(fork_join_pool& pool, unsigned int& seed)
+{
+    fork_join_task* task;
+
+    if(work_stealing_deque_pop(&pool.deques[fork_join_worker], &task) == 0){
+        return task;
+    }
+    for(size_t i=0; i<pool.deques.size(); i++){
+        seed = seed * 1103515245u + 12345u;
+        size_t victim = (seed >> 16) % pool.deques.size();
+        if((int)victim != fork_join_worker && work_stealing_deque_steal(&pool.deques[victim], &task) == 0){
+            return task;
+        }
+    }
+    return NULL;
+}
+
+void fork_join_fib(fork_join_pool& pool, fork_join_task* task);
+
+void fork_join_run(fork_join_pool& pool, fork_join_task* task)
+{
+    fork_join_fib(pool, task);
+    task->done.store(true, std::memory_order_release);
+}
+
+void fork_join_fib(fork_join_pool& pool, fork_join_task* task)
+{
+    if(task->n < FORK_JOIN_CUTOFF){
+        task->result = fib_sequential(task->n);
+        return;
+    }
+
+    fork_join_task a, b;
+    fork_join_task* pa = &a;
+    unsigned int seed = (unsigned int)task->n;
+    a.n = task->n - 1;
+    a.done = false;
+    b.n = task->n - 2;
+
+    work_stealing_deque_push(&pool.deques[fork_join_worker], &pa);
+    fork_join_fib(pool, &b);
+
+    /* help while waiting for the forked half */
+    while(!a.done.load(std::memory_order_acquire)){
+        fork_join_task* other = fork_join_find(pool, seed);
+        if(other){
+            fork_join_run(pool, other);
+        }
+        else{
+            std::this_thread::yield();
+        }
+    }
+
+    task->result = a.result + b.result;
+}
+
+double fork_join_benchmark(int threads, long* result)
+{
+    fork_join_pool pool;
+    std::vector<std::thread> workers;
+    fork_join_task root;
+
+    pool.deques.resize(threads);
+    for(int t=0; t<threads; t++){
+        work_stealing_deque_create(&pool.deques[t], sizeof(fork_join_task*));
+    }
+    pool.stop = false;
+    root.n = FORK_JOIN_FIB;
+    root.done = false;
+
+    for(int t=1; t<threads; t++){
+        workers.emplace_back([&pool, t](){
+            unsigned int seed = (unsigned int)t;
+            fork_join_worker = t;
+            while(!pool.stop.load(std::memory_order_acquire)){
+                fork_join_task* task = fork_join_find(pool, seed);
+                if(task){
+                    fork_join_run(pool, task);
+                }
+                else{
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    fork_join_worker = 0;
+    fork_join_run(pool, &root);
+    auto end = std::chrono::steady_clock::now();
+
+    pool.stop = true;
+    for(auto& worker : workers){
+        worker.join();
+    }
+    for(int t=0; t<threads; t++){
+        work_stealing_deque_destroy(&pool.deques[t]);
+    }
+
+    *result = root.result;
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/* per operation cost of epoch reclamation, single threaded */
+void epoch_overhead_benchmark(double* enter_exit, double* plain_free, double* retire)
+{
+    epoch_domain_t domain;
+    epoch_thread_t* self;
+    std::vector<void*> nodes(BENCH_EPOCH);
+
+    epoch_domain_create(&domain, 0);
+    self = epoch_register(&domain);
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i=0; i<BENCH_EPOCH; i++){
+        epoch_enter(self);
+        clobber();
+        epoch_exit(self);
+    }
+    auto end = std::chrono::steady_clock::now();
+    *enter_exit = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_EPOCH;
+
+    for(int i=0; i<BENCH_EPOCH; i++){
+        nodes[i] = malloc(16);
+    }
+    start = std::chrono::steady_clock::now();
+    for(int i=0; i<BENCH_EPOCH; i++){
+        free(nodes[i]);
+    }
+    end = std::chrono::steady_clock::now();
+    *plain_free = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_EPOCH;
+
+    for(int i=0; i<BENCH_EPOCH; i++){
+        nodes[i] = malloc(16);
+    }
+    start = std::chrono::steady_clock::now();
+    for(int i=0; i<BENCH_EPOCH; i++){
+        epoch_retire(self, nodes[i], NULL);
+    }
+    epoch_unregister(self);
+    end = std::chrono::steady_clock::now();
+    *retire = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_EPOCH;
+
+    epoch_domain_destroy(&domain);
+}
+
+/* stress test: a Treiber stack of malloc'd nodes, popped nodes being retired. Without epoch
+ * reclamation, a thread could read the next field of a node freed by another thread */
+struct epoch_stack_node {
+    epoch_stack_node* next;
+    long value;
+};
+
+double epoch_stress_benchmark(int threads, bool* ok)
+{
+    epoch_domain_t domain;
+    epoch_stack_node* head = NULL;
+    std::vector<long> pushed(threads, 0), popped(threads, 0);
+
+    epoch_domain_create(&domain, 0);
+
+    double time = run_threads(threads, [&domain, &head, &pushed, &popped](int t, int ops){
+        epoch_thread_t* self = epoch_register(&domain);
+        for(int i=0; i<ops; i++){
+            if(i & 1){
+                epoch_enter(self);
+                epoch_stack_node* node = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+                while(node && !__atomic_compare_exchange_n(&head, &node, __atomic_load_n(&node->next, __ATOMIC_RELAXED), true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)){
+                }
+                epoch_exit(self);
+                if(node){
+                    popped[t] += node->value;
+                    epoch_retire(self, node, NULL);
+                }
+            }
+            else{
+                epoch_stack_node* node = (epoch_stack_node*)malloc(sizeof(epoch_stack_node));
+                node->value = (long)t * ops + i;
+                pushed[t] += node->value;
+                node->next = __atomic_load_n(&head, __ATOMIC_RELAXED);
+                while(!__atomic_compare_exchange_n(&head, &node->next, node, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)){
+                }
+            }
+        }
+        epoch_unregister(self);
+    });
+
+    long total_pushed = 0, total_popped = 0;
+    for(int t=0; t<threads; t++){
+        total_pushed += pushed[t];
+        total_popped += popped[t];
+    }
+    while(head){
+        epoch_stack_node* next = head->next;
+        total_popped += head->value;
+        free(head);
+        head = next;
+    }
+    *ok = total_pushed == total_popped;
+
+    epoch_domain_destroy(&domain);
+    return time;
+}
+
+#ifdef STDCONTAINERS_STATS
+/* replay the int push_back/sort/contains/pop workload on a vector_t and a list_t and print what they counted */
+void print_container_stats()
+{
+    vector_t vector;
+    list_t list;
+    container_stats_t vs, ls;
+    int value;
+
+    vector_create(&vector, sizeof(int));
+    list_create(&list, sizeof(int));
+    list_set_comparator(&list, &int_comparator);
+
+    for(int i=0; i<BENCH_SORT; i++){
+        value = rand();
+        vector_push_back(&vector, &value);
+        list_push_back(&list, &value);
+    }
+    vector_sort(&vector, &int_comparator);
+    list_sort(&list);
+    for(int i=0; i<100; i++){
+        value = rand();
+        list_contains(&list, &value);
+    }
+    for(int i=0; i<BENCH_SORT; i++){
+        vector_pop_back(&vector, NULL);
+        list_pop_front(&list, NULL);
+    }
+
+    vector_get_stats(&vector, &vs);
+    list_get_stats(&list, &ls);
+    vector_destroy(&vector);
+    list_destroy(&list);
+
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| STDCONTAINERS_STATS | %dM push_back, sort, 100 contains (list), %dM pops          |\n", BENCH_SORT / 1000000, BENCH_SORT / 1000000);
+    printf("| ------------------- | -------------- | -------------- |                         |\n");
+    printf("|                     |       vector_t |         list_t |                         |\n");
+    printf("|         allocations | %14llu | %14llu |                         |\n", (unsigned long long)vs.allocations, (unsigned long long)ls.allocations);
+    printf("|               frees | %14llu | %14llu |                         |\n", (unsigned long long)vs.frees, (unsigned long long)ls.frees);
+    printf("|     bytes allocated | %14llu | %14llu |                         |\n", (unsigned long long)vs.bytes_allocated, (unsigned long long)ls.bytes_allocated);
+    printf("|            reallocs | %14llu | %14llu |                         |\n", (unsigned long long)vs.reallocs, (unsigned long long)ls.reallocs);
+    printf("|       grows/shrinks | %6llu/%-7llu | %6llu/%-7llu |                         |\n", (unsigned long long)vs.grows, (unsigned long long)vs.shrinks, (unsigned long long)ls.grows, (unsigned long long)ls.shrinks);
+    printf("|            max size | %14llu | %14llu |                         |\n", (unsigned long long)vs.max_size, (unsigned long long)ls.max_size);
+    printf("|         comparisons | %14llu | %14llu |                         |\n", (unsigned long long)vs.comparisons, (unsigned long long)ls.comparisons);
+    printf("-----------------------------------------------------------------------------------\n");
+}
+#endif
+
+int main()
+{
+    srand(time(0));
+
+    printf("stdcontainers C library vs C++ STL benchmark\n");
+
+
     printf("-----------------------------------------------------------------------------------\n");
     printf("|        type: int  |    list_t    |  std::list   | note                          |\n");
     printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
     printf("|        push_back  | %11.4fs | %11.4fs | time to push %dM integers to a list     |\n", stdcontainers_list_push_back_benchmark(),  stl_list_push_back_benchmark(), BENCH_PUSH_BACK / 1000000);
     printf("|          iterate  | %11.4fs | %11.4fs | time to iterate through %dM elements    |\n", stdcontainers_list_iterate_benchmark(), stl_list_iterate_benchmark(), BENCH_ITERATE / 1000000);
+    printf("|  iterate (cursor) | %11.4fs | %11.4fs | time to iterate through %dM elements    |\n", stdcontainers_list_cursor_iterate_benchmark(), stl_list_iterate_benchmark(), BENCH_ITERATE / 1000000);
     printf("|             sort  | %11.4fs | %11.4fs | time to sort %dM elements               |\n", stdcontainers_list_sort_benchmark(), stl_list_sort_benchmark(), BENCH_SORT / 1000000);
     printf("-----------------------------------------------------------------------------------\n");
+    printf("|        type: int  |forward_list_t|std::fwd_list | note                          |\n");
+    printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
+    printf("|        push_back  | %11.4fs | %11.4fs | time to push %dM integers to a list     |\n", stdcontainers_forward_list_push_back_benchmark(), stl_forward_list_push_back_benchmark(), BENCH_PUSH_BACK / 1000000);
+    printf("|          iterate  | %11.4fs | %11.4fs | time to iterate through %dM elements    |\n", stdcontainers_forward_list_iterate_benchmark(), stl_forward_list_iterate_benchmark(), BENCH_ITERATE / 1000000);
+    printf("|             sort  | %11.4fs | %11.4fs | time to sort %dM elements               |\n", stdcontainers_forward_list_sort_benchmark(), stl_forward_list_sort_benchmark(), BENCH_SORT / 1000000);
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| add_ordered %dK int |    list_t    | list_t finger | forward_list_t | forward finger |\n", BENCH_ORDERED / 1000);
+    printf("| ------------------- | ------------ | ------------- | -------------- | -------------- |\n");
+    for(int stream=0; stream<ORDERED_STREAMS; stream++){
+        printf("| %19s | %11.4fs | %12.4fs | %13.4fs | %13.4fs |\n", ordered_stream_names[stream],
+            add_ordered_benchmark(false, false, stream), add_ordered_benchmark(false, true, stream),
+            add_ordered_benchmark(true, false, stream), add_ordered_benchmark(true, true, stream));
+    }
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| batch of %dK int   | add_ordered  | add_ordered_n| std::list::merge | into a sorted list of %dK |\n", ORDERED_BATCH / 1000, ORDERED_BASE / 1000);
+    printf("| ------------------ | ------------ | ------------ | ---------------- | -------------------------- |\n");
+    printf("|          list_t    | %11.4fs | %11.4fs | %15.4fs |                            |\n", add_ordered_batch_benchmark(false), add_ordered_batch_benchmark(true), stl_list_merge_batch_benchmark());
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("|  shuffled nodes   |    list_t    |  std::list   | note                          |\n");
+    printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
+    printf("|          iterate  | %11.4fs | %11.4fs | time to iterate through %dM elements    |\n", stdcontainers_list_iterate_shuffled_benchmark(), stl_list_iterate_shuffled_benchmark(), BENCH_SHUFFLED / 1000000);
+    printf("|         contains  | %11.4fs | %11.4fs | time to search %dM elements             |\n", stdcontainers_list_contains_shuffled_benchmark(), stl_list_find_shuffled_benchmark(), BENCH_SHUFFLED / 1000000);
+    printf("|            clear  | %11.4fs | %11.4fs | time to clear %dM elements              |\n", stdcontainers_list_clear_shuffled_benchmark(), stl_list_clear_shuffled_benchmark(), BENCH_SHUFFLED / 1000000);
+    printf("-----------------------------------------------------------------------------------\n");
+    double fresh, churned, compact, compacted, locality[4];
+    stdcontainers_list_churn_benchmark(&fresh, &churned, &compact, &compacted, locality);
+    printf("|   list_compact    |    list_t    | note                                         |\n");
+    printf("| ----------------- | ------------ | -------------------------------------------- |\n");
+    printf("|    fresh iterate  | %11.4fs | iterate one of %d lists built round robin    |\n", fresh, CHURN_LISTS);
+    printf("|  churned iterate  | %11.4fs | same list after %dM random pop/push moves    |\n", churned, (BENCH_CHURN * 4) / 1000000);
+    printf("|          compact  | %11.4fs | time to compact the churned list            |\n", compact);
+    printf("| compacted iterate | %11.4fs | same list after list_compact                |\n", compacted);
+    printf("| churned adjacent  | %11.1f%% | links to a node within the next 64 bytes    |\n", locality[0]);
+    printf("| churned forward   | %11.1f%% | links to a node at a higher address         |\n", locality[1]);
+    printf("|compacted adjacent | %11.1f%% | links to a node within the next 64 bytes    |\n", locality[2]);
+    printf("|compacted forward  | %11.1f%% | links to a node at a higher address         |\n", locality[3]);
+    printf("-----------------------------------------------------------------------------------\n");
     printf("|        type: int  |   vector_t   | std::vector  | note |\n");
     printf("| ----------------- | ------------ | ------------ | ---------------|\n");
     printf("|        push_back  | %11.4fs | %11.4fs | time to push %dM integers to a vector |\n", stdcontainers_vector_push_back_benchmark(),  stl_vector_push_back_benchmark(), BENCH_PUSH_BACK / 1000000);
     printf("|          iterate  | %11.4fs | %11.4fs | time to iterate through %dM elements |\n", stdcontainers_vector_iterate_benchmark(), stl_vector_iterate_benchmark(), BENCH_ITERATE / 1000000);
     printf("|             sort  | %11.4fs | %11.4fs | time to sort %dM elements |\n", stdcontainers_vector_sort_benchmark(), stl_vector_sort_benchmark(), BENCH_SORT / 1000000);
     printf("-----------------------------------------------------------------------------------\n");
+    printf("-------------------------------------------------------------------------------------------------------------------\n");
+    printf("| sort %dM int   | vector_sort  | vector_stable_sort | vector_int_sort |  list_sort   |  std::sort   | std::stable_sort |\n", BENCH_SORT / 1000000);
+    printf("| -------------- | ------------ | ------------------ | --------------- | ------------ | ------------ | ---------------- |\n");
+    for(int distribution=0; distribution<SORT_DISTRIBUTIONS; distribution++){
+        printf("| %14s | %11.4fs | %17.4fs | %14.4fs | %11.4fs | %11.4fs | %15.4fs |\n", sort_distribution_names[distribution],
+            sort_distribution_benchmark(SORT_VECTOR, distribution), sort_distribution_benchmark(SORT_VECTOR_STABLE, distribution),
+            sort_distribution_benchmark(SORT_VECTOR_TYPED, distribution), sort_distribution_benchmark(SORT_LIST, distribution),
+            sort_distribution_benchmark(SORT_STL, distribution), sort_distribution_benchmark(SORT_STL_STABLE, distribution));
+    }
+    printf("-------------------------------------------------------------------------------------------------------------------\n");
+    std::vector<int> topk_values(BENCH_TOPK);
+    for(int i=0; i<BENCH_TOPK; i++){
+        topk_values[i] = rand();
+    }
+    printf("| top %d of %dM int | full sort    | partial_sort | nth_element  | topk_t       |\n", TOPK_K, BENCH_TOPK / 1000000);
+    printf("| ------------------ | ------------ | ------------ | ------------ | ------------ |\n");
+    printf("| stdcontainers      | %11.4fs | %11.4fs | %11.4fs | %11.4fs |\n", topk_benchmark(TOPK_VECTOR_SORT, topk_values),
+        topk_benchmark(TOPK_VECTOR_PARTIAL_SORT, topk_values), topk_benchmark(TOPK_VECTOR_NTH_ELEMENT, topk_values), topk_benchmark(TOPK_ACCUMULATOR, topk_values));
+    printf("| STL                | %11.4fs | %11.4fs | %11.4fs |      n/a     |\n", topk_benchmark(TOPK_STL_SORT, topk_values),
+        topk_benchmark(TOPK_STL_PARTIAL_SORT, topk_values), topk_benchmark(TOPK_STL_NTH_ELEMENT, topk_values));
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| external sort %dM int  | vector_sort  | external_sort | overlapped   | note         |\n", BENCH_EXTERNAL / 1000000);
+    printf("| --------------------- | ------------ | ------------- | ------------ | ------------ |\n");
+    printf("| %dMB runs              | %11.4fs | %12.4fs | %11.4fs | wall clock   |\n", EXTERNAL_RUN_SIZE >> 20, external_sort_in_memory_benchmark(), external_sort_benchmark(false), external_sort_benchmark(true));
+    printf("-----------------------------------------------------------------------------------\n");
+    double mapped[MAPPED_STEPS];
+    bool mapped_ok = mapped_vector_benchmark(mapped);
+    printf("| mapped_vector     |    time      | note                                         |\n");
+    printf("| ----------------- | ------------ | -------------------------------------------- |\n");
+    printf("|    create + grow  | %11.4fs | push %dM integers from the minimum capacity  |\n", mapped[MAPPED_CREATE], BENCH_MAPPED / 1000000);
+    printf("|           reopen  | %11.4fs | reopen the file, nothing is read upfront     |\n", mapped[MAPPED_REOPEN]);
+    printf("|        read back  | %11.4fs | sum all elements, paged in on demand         |\n", mapped[MAPPED_READ]);
+    printf("| shrink + reopen   | %11.4fs | pop half, shrink_to_fit, reopen              |\n", mapped[MAPPED_SHRINK]);
+    printf("|       round trip  | %12s | elements and capacity survive every reopen   |\n", mapped_ok ? "ok" : "FAILED");
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| snapshot %dM int   |     save     |     load     | round trip   |\n", BENCH_SNAPSHOT / 1000000);
+    printf("| ----------------- | ------------ | ------------ | ------------ |\n");
+    for(int kind=SNAPSHOT_VECTOR; kind<=SNAPSHOT_FORWARD_LIST; kind++){
+        double save, load;
+        bool ok = snapshot_benchmark((snapshot_kind_t)kind, &save, &load);
+        printf("| %17s | %11.4fs | %11.4fs | %12s |\n", snapshot_kind_names[kind], save, load, ok ? "ok" : "FAILED");
+    }
+    printf("|  corrupt headers  |          n/a |          n/a | %12s |\n", snapshot_reject_benchmark() ? "rejected" : "ACCEPTED");
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| filter, type: int |  remove_if   | erase loop   | std::remove_if | note         |\n");
+    printf("| ----------------- | ------------ | ------------ | -------------- | ------------ |\n");
+    printf("| vector_t, drop odd| %11.4fs | %11.4fs | %13.4fs | %dK elements |\n", vector_remove_if_benchmark(false), vector_remove_if_benchmark(true), stl_vector_remove_if_benchmark(), BENCH_REMOVE / 1000);
+    printf("|  list_t, purge    | %11.4fs | %11.4fs | %13.4fs | %dM elements   |\n", list_remove_if_benchmark(false), list_remove_if_benchmark(true), stl_list_remove_if_benchmark(), BENCH_SORT / 1000000);
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| FIFO, type: int   |   vector_t   |  shift left  |  std::deque  | note           |\n");
+    printf("| ----------------- | ------------ | ------------ | ------------ | -------------- |\n");
+    printf("|     batch drain   | %11.4fs | %11.4fs | %11.4fs | %dK pops      |\n", vector_fifo_benchmark(false, false), vector_fifo_benchmark(true, false), stl_deque_fifo_benchmark(false), BENCH_FIFO / 1000);
+    printf("|   steady queue    | %11.4fs | %11.4fs | %11.4fs | %d queued    |\n", vector_fifo_benchmark(false, true), vector_fifo_benchmark(true, true), stl_deque_fifo_benchmark(true), FIFO_LENGTH);
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| type: record256   | push_back    | emplace_back | std::vector::emplace_back     |\n");
+    printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
+    printf("|         vector_t  | %11.4fs | %11.4fs | %28.4fs |\n", stdcontainers_vector_record_benchmark(false), stdcontainers_vector_record_benchmark(true), stl_vector_record_benchmark());
+    printf("|           list_t  | %11.4fs | %11.4fs | %dK 256 byte records         |\n", stdcontainers_list_record_benchmark(false), stdcontainers_list_record_benchmark(true), BENCH_EMPLACE / 1000);
+    printf("-----------------------------------------------------------------------------------\n");
 
     printf("-----------------------------------------------------------------------------------\n");
     printf("|   type: vector2f  |    list_t    |  std::list   | note                          |\n");
@@ -665,7 +3083,103 @@ int main()
     printf("|             sort  | %11.4fs | %11.4fs | time to sort %dM elements               |\n", stdcontainers_vector_sort_v2f_benchmark(), stl_vector_sort_v2f_benchmark(), BENCH_SORT / 1000000);
     printf("-----------------------------------------------------------------------------------\n");
 
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("|        type: int  | vector_int_t |   vector_t   | note                          |\n");
+    printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
+    printf("|        push_back  | %11.4fs | %11.4fs | time to push %dM integers to a vector   |\n", typed_vector_push_back_benchmark(), stdcontainers_vector_push_back_benchmark(), BENCH_PUSH_BACK / 1000000);
+    printf("|          iterate  | %11.4fs | %11.4fs | time to iterate through %dM elements    |\n", typed_vector_iterate_benchmark(), stdcontainers_vector_iterate_benchmark(), BENCH_ITERATE / 1000000);
+    printf("|             sort  | %11.4fs | %11.4fs | time to sort %dM elements               |\n", typed_vector_sort_benchmark(), stdcontainers_vector_sort_benchmark(), BENCH_SORT / 1000000);
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("|        type: int  |  list_int_t  |    list_t    | note                          |\n");
+    printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
+    printf("|        push_back  | %11.4fs | %11.4fs | time to push %dM integers to a list     |\n", typed_list_push_back_benchmark(), stdcontainers_list_push_back_benchmark(), BENCH_PUSH_BACK / 1000000);
+    printf("|          iterate  | %11.4fs | %11.4fs | time to iterate through %dM elements    |\n", typed_list_iterate_benchmark(), stdcontainers_list_iterate_benchmark(), BENCH_ITERATE / 1000000);
+    printf("|             sort  | %11.4fs | %11.4fs | time to sort %dM elements               |\n", typed_list_sort_benchmark(), stdcontainers_list_sort_benchmark(), BENCH_SORT / 1000000);
+    printf("-----------------------------------------------------------------------------------\n");
+
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("|        type: int  | stdc::vector | std::vector  | note                          |\n");
+    printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
+    printf("|        push_back  | %11.4fs | %11.4fs | time to push %dM integers to a vector   |\n", stdc_vector_push_back_benchmark(), stl_vector_push_back_benchmark(), BENCH_PUSH_BACK / 1000000);
+    printf("|          iterate  | %11.4fs | %11.4fs | time to iterate through %dM elements    |\n", stdc_vector_iterate_benchmark(), stl_vector_iterate_benchmark(), BENCH_ITERATE / 1000000);
+    printf("|        std::sort  | %11.4fs | %11.4fs | time to sort %dM elements               |\n", stdc_vector_sort_benchmark(), stl_vector_sort_benchmark(), BENCH_SORT / 1000000);
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("|        type: int  |  stdc::list  |  std::list   | note                          |\n");
+    printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
+    printf("|        push_back  | %11.4fs | %11.4fs | time to push %dM integers to a list     |\n", stdc_list_push_back_benchmark(), stl_list_push_back_benchmark(), BENCH_PUSH_BACK / 1000000);
+    printf("|          iterate  | %11.4fs | %11.4fs | time to iterate through %dM elements    |\n", stdc_list_iterate_benchmark(), stl_list_iterate_benchmark(), BENCH_ITERATE / 1000000);
+    printf("-----------------------------------------------------------------------------------\n");
+
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("|  zipf: get/put    | lru_cache_t  | list+hashmap | note                          |\n");
+    printf("| ----------------- | ------------ | ------------ | ----------------------------- |\n");
+    const double zipf_exponents[] = { 0.8, 0.99, 1.2 };
+    for(double s : zipf_exponents){
+        std::vector<uint64_t> keys = zipf_keys(s);
+        double hit_rate;
+        double lru_time = stdcontainers_lru_cache_benchmark(keys, &hit_rate);
+        printf("|         s = %.2f  | %11.4fs | %11.4fs | %dM lookups, hit rate %5.1f%%   |\n", s, lru_time, stl_lru_cache_benchmark(keys), BENCH_LRU / 1000000, hit_rate * 100.0);
+    }
+    printf("-----------------------------------------------------------------------------------\n");
+
+    printf("-------------------------------------------------------------------------------------------------------------------\n");
+    printf("| contention, wall clock | %dM ops in total, split between threads                                             |\n", BENCH_CONCURRENT / 1000000);
+    printf("| threads | concurrent_vector | mutex + vector_t | concurrent_list | mutex + list_t | concurrent_lru | mutex + lru |\n");
+    printf("| ------- | ----------------- | ---------------- | --------------- | -------------- | -------------- | ----------- |\n");
+    std::vector<uint64_t> concurrent_keys = zipf_keys(0.99);
+    for(int threads=1; threads<=CONCURRENT_MAX_THREADS; threads<<=1){
+        printf("| %7d | %16.4fs | %15.4fs | %14.4fs | %13.4fs | %13.4fs | %10.4fs |\n", threads,
+            concurrent_vector_benchmark(threads), mutex_vector_benchmark(threads),
+            concurrent_list_benchmark(threads), mutex_list_benchmark(threads),
+            concurrent_lru_cache_benchmark(threads, concurrent_keys), mutex_lru_cache_benchmark(threads, concurrent_keys));
+    }
+    printf("-------------------------------------------------------------------------------------------------------------------\n");
+
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| contention, wall clock | %dM push/pop in total, split between threads           |\n", BENCH_CONCURRENT / 1000000);
+    printf("| threads | lockfree_stack | + elimination | mutex + stack_t                      |\n");
+    printf("| ------- | -------------- | ------------- | ------------------------------------ |\n");
+    for(int threads=1; threads<=CONCURRENT_MAX_THREADS; threads<<=1){
+        printf("| %7d | %13.4fs | %12.4fs | %11.4fs                         |\n", threads,
+            lockfree_stack_benchmark(threads, 0), lockfree_stack_benchmark(threads, (size_t)(threads + 1) / 2), mutex_stack_benchmark(threads));
+    }
+    printf("-----------------------------------------------------------------------------------\n");
+
+    int cores = (int)std::thread::hardware_concurrency();
+    if(cores < 1) cores = 1;
+    auto fib_start = std::chrono::steady_clock::now();
+    long fib_expected = fib_sequential(FORK_JOIN_FIB);
+    double fib_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - fib_start).count();
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| fork/join fib(%d) | work_stealing_deque_t | note                                |\n", FORK_JOIN_FIB);
+    printf("| ----------------- | --------------------- | ----------------------------------- |\n");
+    printf("|       sequential  | %20.4fs | plain recursion                     |\n", fib_time);
+    for(int threads=1; threads<=cores; threads = threads < cores && threads * 2 > cores ? cores : threads * 2){
+        long result;
+        double time = fork_join_benchmark(threads, &result);
+        printf("| %6d thread(s)  | %20.4fs | speedup x%-5.2f %-20s |\n", threads, time, fib_time / time, result == fib_expected ? "" : "WRONG RESULT");
+    }
+    printf("-----------------------------------------------------------------------------------\n");
+
+    double enter_exit, plain_free, retire;
+    epoch_overhead_benchmark(&enter_exit, &plain_free, &retire);
+    printf("-----------------------------------------------------------------------------------\n");
+    printf("| epoch reclamation |     ns/op    | note                                         |\n");
+    printf("| ----------------- | ------------ | -------------------------------------------- |\n");
+    printf("|     enter + exit  | %12.2f | empty critical section                       |\n", enter_exit);
+    printf("|             free  | %12.2f | immediate free, unsafe with lock-free readers |\n", plain_free);
+    printf("|           retire  | %12.2f | retire, batched free included               |\n", retire);
+    printf("| ----------------- | ------------ | -------------------------------------------- |\n");
+    for(int threads=1; threads<=CONCURRENT_MAX_THREADS; threads<<=1){
+        bool ok;
+        double time = epoch_stress_benchmark(threads, &ok);
+        printf("| stress %2d threads | %11.4fs | Treiber stack, %dM push/pop %-17s |\n", threads, time, BENCH_CONCURRENT / 1000000, ok ? "ok" : "FAILED");
+    }
+    printf("-----------------------------------------------------------------------------------\n");
 
+#ifdef STDCONTAINERS_STATS
+    print_container_stats();
+#endif
 
     return 0;
 }
\ No newline at end of file
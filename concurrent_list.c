@@ -0,0 +1,224 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file concurrent_list.c
+@author Tony Pottier
+@brief Source code for the spinlock guarded list
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L /* sched_yield, called by spinlock.h */
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "concurrent_list.h"
+#include "prefetch.h"
+
+
+int concurrent_list_create(concurrent_list_t* list, size_t size_type)
+{
+	if (!list) return -1;
+
+	list_create(&list->list, size_type);
+	spinlock_init(&list->lock);
+
+	return 0;
+}
+
+void concurrent_list_destroy(concurrent_list_t* list)
+{
+	list_destroy(&list->list);
+}
+
+/**
+ * @brief credit the wrapped list with the nodes allocated by batch. The lock must be held.
+ */
+static inline void _concurrent_list_account(concurrent_list_t* list, const list_t* batch)
+{
+	STDCONTAINERS_STATS_ADD(&list->list, allocations, batch->stats.allocations);
+	STDCONTAINERS_STATS_ADD(&list->list, bytes_allocated, batch->stats.bytes_allocated);
+	(void)list;
+	(void)batch;
+}
+
+/**
+ * @brief link the already filled nodes of batch at the end of list, under the lock
+ */
+static inline void _concurrent_list_append(concurrent_list_t* list, list_t* batch)
+{
+	spinlock_lock(&list->lock);
+	_concurrent_list_account(list, batch);
+	list_splice(&list->list, NULL, batch);
+	spinlock_unlock(&list->lock);
+}
+
+int concurrent_list_push_back(concurrent_list_t* list, const void* data)
+{
+	list_t batch;
+
+	list_create(&batch, list->list.size_type);
+	if (!list_push_back(&batch, data)) return -1;
+
+	_concurrent_list_append(list, &batch);
+
+	return 0;
+}
+
+int concurrent_list_push_front(concurrent_list_t* list, const void* data)
+{
+	list_t batch;
+
+	list_create(&batch, list->list.size_type);
+	if (!list_push_back(&batch, data)) return -1;
+
+	spinlock_lock(&list->lock);
+	_concurrent_list_account(list, &batch);
+	list_splice(&list->list, list->list.begin, &batch);
+	spinlock_unlock(&list->lock);
+
+	return 0;
+}
+
+int concurrent_list_push_back_n(concurrent_list_t* list, const void* data, size_t count)
+{
+	const uint8_t* p = (const uint8_t*)data;
+	list_t batch;
+	size_t i;
+
+	list_create(&batch, list->list.size_type);
+
+	for (i = 0; i < count; i++) {
+		if (!list_push_back(&batch, p + i * batch.size_type)) {
+			list_clear(&batch);
+			return -1;
+		}
+	}
+
+	_concurrent_list_append(list, &batch);
+
+	return 0;
+}
+
+int concurrent_list_pop_front(concurrent_list_t* list, void* data)
+{
+	return concurrent_list_pop_front_n(list, data, 1) ? 0 : -1;
+}
+
+int concurrent_list_pop_back(concurrent_list_t* list, void* data)
+{
+	node_t* last;
+
+	/* list_pop_back_node also drops the finger if it was on the detached node */
+	spinlock_lock(&list->lock);
+	last = list_pop_back_node(&list->list);
+	if (last) {
+		STDCONTAINERS_STATS_INC(&list->list, frees);
+	}
+	spinlock_unlock(&list->lock);
+
+	if (!last) return -1;
+
+	if (data) {
+		memcpy(data, last->data, list->list.size_type);
+	}
+	free(last);
+
+	return 0;
+}
+
+size_t concurrent_list_pop_front_n(concurrent_list_t* list, void* data, size_t max)
+{
+	uint8_t* p = (uint8_t*)data;
+	node_t* first;
+	node_t* last;
+	node_t* next;
+	size_t count = 0;
+
+	if (max == 0) return 0;
+
+	/* detach the chain of the first max nodes, copying and freeing happen outside of the lock.
+	 * The stats counters are not atomic: the frees are credited here, while the lock is held */
+	spinlock_lock(&list->lock);
+	first = list->list.begin;
+	if (first) {
+		last = first;
+		for (count = 1; count < max && last->next != NULL; count++) {
+			if (last == list->list.finger) {
+				list->list.finger = NULL;
+			}
+			last = last->next;
+		}
+		if (last == list->list.finger) {
+			list->list.finger = NULL;
+		}
+		list->list.begin = last->next;
+		if (list->list.begin) {
+			list->list.begin->previous = NULL;
+		}
+		else {
+			list->list.end = NULL;
+		}
+		list->list.size -= (int)count;
+		last->next = NULL;
+		STDCONTAINERS_STATS_ADD(&list->list, frees, count);
+	}
+	spinlock_unlock(&list->lock);
+
+	while (first != NULL) {
+		next = first->next;
+		STDCONTAINERS_PREFETCH(next);
+		if (p) {
+			memcpy(p, first->data, list->list.size_type);
+			p += list->list.size_type;
+		}
+		free(first);
+		first = next;
+	}
+
+	return count;
+}
+
+size_t concurrent_list_size(concurrent_list_t* list)
+{
+	size_t size;
+
+	spinlock_lock(&list->lock);
+	size = (size_t)list->list.size;
+	spinlock_unlock(&list->lock);
+
+	return size;
+}
+
+list_t* concurrent_list_lock(concurrent_list_t* list)
+{
+	spinlock_lock(&list->lock);
+	return &list->list;
+}
+
+void concurrent_list_unlock(concurrent_list_t* list)
+{
+	spinlock_unlock(&list->lock);
+}
@@ -0,0 +1,142 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file concurrent_list.h
+@author Tony Pottier
+@brief Thread-safe list guarded by a ticket spinlock, with batched push and pop
+
+concurrent_list_t wraps a list_t with a spinlock_t. Nodes are allocated and
+freed outside of the lock: a push only links an already filled node and a pop
+only unlinks one, which keeps critical sections down to a few pointer writes.
+
+concurrent_list_push_back_n and concurrent_list_pop_front_n move a whole
+batch of elements under a single lock acquisition. Use them for producer /
+consumer queues where each thread handles many elements at once.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _CONCURRENT_LIST_H_
+#define _CONCURRENT_LIST_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "list.h"
+#include "spinlock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct concurrent_list_t {
+	list_t list;
+	spinlock_t lock;
+}concurrent_list_t;
+
+
+/**
+  * @brief initialize an empty concurrent list
+  * @param      list: pointer to the concurrent_list_t struct to be initialized
+  * @param		size_type: size in bytes of the elements to be stored
+  * @return		0: success
+  *				-1: failure
+  */
+int concurrent_list_create(concurrent_list_t* list, size_t size_type);
+
+/**
+  * @brief free all elements of the list. No other thread may be using the list.
+  * @param  list: the list to perform the operation on
+  */
+void concurrent_list_destroy(concurrent_list_t* list);
+
+/**
+  * @brief add an element at the end of the list
+  * @return 0: success
+  *         -1: failure
+  */
+int concurrent_list_push_back(concurrent_list_t* list, const void* data);
+
+/**
+  * @brief add an element at the beginning of the list
+  * @return 0: success
+  *         -1: failure
+  */
+int concurrent_list_push_front(concurrent_list_t* list, const void* data);
+
+/**
+  * @brief add count elements at the end of the list under a single lock acquisition.
+  * The elements appear atomically to the other threads, in array order.
+  * @param  list: the list to perform the operation on
+  * @param  data: array of count elements
+  * @param  count: number of elements to add
+  * @return 0: success
+  *         -1: failure. The list is left untouched
+  */
+int concurrent_list_push_back_n(concurrent_list_t* list, const void* data, size_t count);
+
+/**
+  * @brief remove the first element of the list
+  * @param  list: the list to perform the operation on
+  * @param  data: receives a copy of the removed element. Can be NULL
+  * @return 0: success
+  *         -1: the list is empty
+  */
+int concurrent_list_pop_front(concurrent_list_t* list, void* data);
+
+/**
+  * @brief remove the last element of the list
+  * @param  list: the list to perform the operation on
+  * @param  data: receives a copy of the removed element. Can be NULL
+  * @return 0: success
+  *         -1: the list is empty
+  */
+int concurrent_list_pop_back(concurrent_list_t* list, void* data);
+
+/**
+  * @brief remove up to max elements from the beginning of the list under a single lock acquisition
+  * @param  list: the list to perform the operation on
+  * @param  data: array receiving copies of the removed elements, in list order. Can be NULL
+  * @param  max: maximum number of elements to remove
+  * @return number of elements removed, 0 if the list is empty
+  */
+size_t concurrent_list_pop_front_n(concurrent_list_t* list, void* data, size_t max);
+
+/**
+  * @brief number of elements in the list. The value may be outdated as soon as it is returned.
+  */
+size_t concurrent_list_size(concurrent_list_t* list);
+
+/**
+  * @brief take the lock and return the underlying list_t, which can be freely used with the
+  * list.h API until concurrent_list_unlock is called. Keep the critical section short.
+  */
+list_t* concurrent_list_lock(concurrent_list_t* list);
+
+void concurrent_list_unlock(concurrent_list_t* list);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
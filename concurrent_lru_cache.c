@@ -0,0 +1,181 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file concurrent_lru_cache.c
+@author Tony Pottier
+@brief Source code for the striped LRU cache
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L /* posix_memalign, and sched_yield called by spinlock.h */
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "concurrent_lru_cache.h"
+
+
+static inline concurrent_lru_stripe_t* _concurrent_lru_cache_stripe_at(concurrent_lru_cache_t* cache, size_t n)
+{
+	return (concurrent_lru_stripe_t*)(cache->stripes + n * cache->stripe_size);
+}
+
+static inline concurrent_lru_stripe_t* _concurrent_lru_cache_stripe(concurrent_lru_cache_t* cache, const void* key)
+{
+	/* each stripe indexes its buckets with the low bits of the hash: pick the stripe from the high bits */
+	uint32_t hash = cache->hash(key, cache->key_size) * 2654435761u;
+
+	return _concurrent_lru_cache_stripe_at(cache, (hash >> 16) & (cache->stripe_count - 1));
+}
+
+
+int concurrent_lru_cache_create(concurrent_lru_cache_t* cache, size_t key_size, size_t value_size, size_t capacity, size_t stripe_count)
+{
+	concurrent_lru_stripe_t* stripe;
+	size_t count = 1, per_stripe, i;
+	void* stripes;
+
+	if (!cache || capacity == 0 || stripe_count == 0 || stripe_count > CONCURRENT_LRU_CACHE_MAX_STRIPES) return -1;
+
+	while (count < stripe_count) {
+		count <<= 1;
+	}
+	per_stripe = (capacity + count - 1) / count;
+
+	memset(cache, 0x00, sizeof(concurrent_lru_cache_t));
+	cache->stripe_size = (sizeof(concurrent_lru_stripe_t) + CONCURRENT_LRU_CACHE_LINE - 1) & ~(size_t)(CONCURRENT_LRU_CACHE_LINE - 1);
+	cache->key_size = key_size;
+	cache->hash = lru_cache_hash_fnv1a;
+
+	if (posix_memalign(&stripes, CONCURRENT_LRU_CACHE_LINE, count * cache->stripe_size) != 0) return -1;
+	cache->stripes = (uint8_t*)stripes;
+
+	for (i = 0; i < count; i++) {
+		stripe = _concurrent_lru_cache_stripe_at(cache, i);
+		spinlock_init(&stripe->lock);
+		if (lru_cache_create(&stripe->cache, key_size, value_size, per_stripe) != 0) {
+			cache->stripe_count = i;
+			concurrent_lru_cache_destroy(cache);
+			return -1;
+		}
+	}
+	cache->stripe_count = count;
+
+	return 0;
+}
+
+void concurrent_lru_cache_destroy(concurrent_lru_cache_t* cache)
+{
+	size_t i;
+
+	for (i = 0; i < cache->stripe_count; i++) {
+		lru_cache_destroy(&_concurrent_lru_cache_stripe_at(cache, i)->cache);
+	}
+	free(cache->stripes);
+	memset(cache, 0x00, sizeof(concurrent_lru_cache_t));
+}
+
+void concurrent_lru_cache_set_eviction_callback(concurrent_lru_cache_t* cache, lru_cache_evict_t on_evict, void* ctx)
+{
+	size_t i;
+
+	for (i = 0; i < cache->stripe_count; i++) {
+		lru_cache_set_eviction_callback(&_concurrent_lru_cache_stripe_at(cache, i)->cache, on_evict, ctx);
+	}
+}
+
+int concurrent_lru_cache_get(concurrent_lru_cache_t* cache, const void* key, void* value)
+{
+	concurrent_lru_stripe_t* stripe = _concurrent_lru_cache_stripe(cache, key);
+	void* cached;
+
+	spinlock_lock(&stripe->lock);
+	cached = lru_cache_get(&stripe->cache, key);
+	if (cached && value) {
+		memcpy(value, cached, stripe->cache.value_size);
+	}
+	spinlock_unlock(&stripe->lock);
+
+	return cached ? 0 : -1;
+}
+
+int concurrent_lru_cache_put(concurrent_lru_cache_t* cache, const void* key, const void* value)
+{
+	concurrent_lru_stripe_t* stripe = _concurrent_lru_cache_stripe(cache, key);
+	int ret;
+
+	spinlock_lock(&stripe->lock);
+	ret = lru_cache_put(&stripe->cache, key, value);
+	spinlock_unlock(&stripe->lock);
+
+	return ret;
+}
+
+int concurrent_lru_cache_erase(concurrent_lru_cache_t* cache, const void* key)
+{
+	concurrent_lru_stripe_t* stripe = _concurrent_lru_cache_stripe(cache, key);
+	int ret;
+
+	spinlock_lock(&stripe->lock);
+	ret = lru_cache_erase(&stripe->cache, key);
+	spinlock_unlock(&stripe->lock);
+
+	return ret;
+}
+
+size_t concurrent_lru_cache_size(concurrent_lru_cache_t* cache)
+{
+	concurrent_lru_stripe_t* stripe;
+	size_t size = 0, i;
+
+	for (i = 0; i < cache->stripe_count; i++) {
+		stripe = _concurrent_lru_cache_stripe_at(cache, i);
+		spinlock_lock(&stripe->lock);
+		size += stripe->cache.size;
+		spinlock_unlock(&stripe->lock);
+	}
+
+	return size;
+}
+
+void concurrent_lru_cache_stats(concurrent_lru_cache_t* cache, uint64_t* hits, uint64_t* misses, uint64_t* evictions)
+{
+	concurrent_lru_stripe_t* stripe;
+	uint64_t h = 0, m = 0, e = 0;
+	size_t i;
+
+	for (i = 0; i < cache->stripe_count; i++) {
+		stripe = _concurrent_lru_cache_stripe_at(cache, i);
+		spinlock_lock(&stripe->lock);
+		h += stripe->cache.hits;
+		m += stripe->cache.misses;
+		e += stripe->cache.evictions;
+		spinlock_unlock(&stripe->lock);
+	}
+
+	if (hits) *hits = h;
+	if (misses) *misses = m;
+	if (evictions) *evictions = e;
+}
@@ -0,0 +1,139 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file concurrent_lru_cache.h
+@author Tony Pottier
+@brief Thread-safe LRU cache sharded into independently locked stripes
+
+The key space is split over a power of two number of stripes, each being an
+lru_cache_t guarded by its own spinlock. Threads working on keys of different
+stripes never contend, so throughput scales with the number of stripes
+instead of serializing every access behind a single lock.
+
+Recency is tracked per stripe: the entry evicted when a stripe is full is the
+least recently used one of that stripe, which approximates a global LRU well
+as long as keys spread evenly over the stripes.
+
+Values are copied out of the cache, since another thread may evict an entry
+as soon as the stripe lock is released.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _CONCURRENT_LRU_CACHE_H_
+#define _CONCURRENT_LRU_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "lru_cache.h"
+#include "spinlock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CONCURRENT_LRU_CACHE_MAX_STRIPES 256
+
+/* stripes are aligned on cache lines so that two locks never share one */
+#define CONCURRENT_LRU_CACHE_LINE 64
+
+typedef struct concurrent_lru_stripe_t {
+	spinlock_t lock;
+	lru_cache_t cache;
+}concurrent_lru_stripe_t;
+
+typedef struct concurrent_lru_cache_t {
+	uint8_t* stripes;
+	size_t stripe_size;
+	size_t stripe_count;
+	size_t key_size;
+	lru_cache_hash_t hash;
+}concurrent_lru_cache_t;
+
+
+/**
+  * @brief initialize a cache holding up to capacity entries spread over stripe_count stripes
+  * @param      cache: pointer to the concurrent_lru_cache_t struct to be initialized
+  * @param		key_size: size in bytes of the keys
+  * @param		value_size: size in bytes of the values
+  * @param		capacity: maximum number of entries held by the cache, rounded up to a multiple of stripe_count
+  * @param		stripe_count: number of stripes, rounded up to a power of two. A few times the number of
+  *				threads accessing the cache is a good start
+  * @return		0: success
+  *				-1: failure
+  */
+int concurrent_lru_cache_create(concurrent_lru_cache_t* cache, size_t key_size, size_t value_size, size_t capacity, size_t stripe_count);
+
+/**
+  * @brief free all memory held by the cache. No other thread may be using the cache.
+  * @param  cache: the cache to perform the operation on
+  */
+void concurrent_lru_cache_destroy(concurrent_lru_cache_t* cache);
+
+/**
+  * @brief register a function called whenever an entry is evicted to make room for a new one.
+  * The callback runs with the stripe locked and must not access the cache. Call this before
+  * sharing the cache with other threads.
+  */
+void concurrent_lru_cache_set_eviction_callback(concurrent_lru_cache_t* cache, lru_cache_evict_t on_evict, void* ctx);
+
+/**
+  * @brief look up a key, copy its value and mark its entry as the most recently used one of its stripe
+  * @param  cache: the cache to perform the operation on
+  * @param  key: the key to look for
+  * @param  value: receives a copy of the value. Can be NULL
+  * @return 0: key found
+  *         -1: key not found
+  */
+int concurrent_lru_cache_get(concurrent_lru_cache_t* cache, const void* key, void* value);
+
+/**
+  * @brief insert a key/value pair, or update the value of an existing key
+  * @return 0: success
+  *         -1: failure
+  */
+int concurrent_lru_cache_put(concurrent_lru_cache_t* cache, const void* key, const void* value);
+
+/**
+  * @brief remove a key from the cache
+  * @return 0: success
+  *         -1: key not found
+  */
+int concurrent_lru_cache_erase(concurrent_lru_cache_t* cache, const void* key);
+
+/**
+  * @brief number of entries held by the cache, summed over all stripes
+  */
+size_t concurrent_lru_cache_size(concurrent_lru_cache_t* cache);
+
+/**
+  * @brief hits, misses and evictions summed over all stripes. Any pointer can be NULL.
+  */
+void concurrent_lru_cache_stats(concurrent_lru_cache_t* cache, uint64_t* hits, uint64_t* misses, uint64_t* evictions);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,156 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file concurrent_vector.c
+@author Tony Pottier
+@brief Source code for the reader/writer locked vector
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L /* pthread rwlocks */
+#endif
+
+#include <string.h>
+#include "concurrent_vector.h"
+
+
+int concurrent_vector_create(concurrent_vector_t* vector, size_t size_type)
+{
+	return concurrent_vector_create_with(vector, size_type, VECTOR_DEFAULT_INITIAL_SIZE);
+}
+
+int concurrent_vector_create_with(concurrent_vector_t* vector, size_t size_type, size_t capacity)
+{
+	if (!vector) return -1;
+
+	if (vector_create_with(&vector->vector, size_type, capacity) != 0) return -1;
+
+	if (pthread_rwlock_init(&vector->lock, NULL) != 0) {
+		vector_destroy(&vector->vector);
+		return -1;
+	}
+
+	return 0;
+}
+
+void concurrent_vector_destroy(concurrent_vector_t* vector)
+{
+	pthread_rwlock_destroy(&vector->lock);
+	vector_destroy(&vector->vector);
+}
+
+int concurrent_vector_at(concurrent_vector_t* vector, size_t n, void* data)
+{
+	int ret = -1;
+
+	pthread_rwlock_rdlock(&vector->lock);
+	if (n < vector->vector.size) {
+		memcpy(data, vector->vector.data + n * vector->vector.size_type, vector->vector.size_type);
+		ret = 0;
+	}
+	pthread_rwlock_unlock(&vector->lock);
+
+	return ret;
+}
+
+int concurrent_vector_assign(concurrent_vector_t* vector, size_t n, const void* data)
+{
+	int ret = -1;
+
+	pthread_rwlock_wrlock(&vector->lock);
+	if (n < vector->vector.size) {
+		memcpy(vector->vector.data + n * vector->vector.size_type, data, vector->vector.size_type);
+		ret = 0;
+	}
+	pthread_rwlock_unlock(&vector->lock);
+
+	return ret;
+}
+
+int concurrent_vector_push_back(concurrent_vector_t* vector, const void* data)
+{
+	int ret;
+
+	pthread_rwlock_wrlock(&vector->lock);
+	ret = vector_push_back(&vector->vector, data);
+	pthread_rwlock_unlock(&vector->lock);
+
+	return ret;
+}
+
+int concurrent_vector_pop_back(concurrent_vector_t* vector, void* data)
+{
+	int ret;
+
+	pthread_rwlock_wrlock(&vector->lock);
+	ret = vector_pop_back(&vector->vector, data);
+	pthread_rwlock_unlock(&vector->lock);
+
+	return ret;
+}
+
+size_t concurrent_vector_size(concurrent_vector_t* vector)
+{
+	size_t size;
+
+	pthread_rwlock_rdlock(&vector->lock);
+	size = vector->vector.size;
+	pthread_rwlock_unlock(&vector->lock);
+
+	return size;
+}
+
+int concurrent_vector_sort(concurrent_vector_t* vector, int (*comp)(const void*, const void*))
+{
+	int ret;
+
+	pthread_rwlock_wrlock(&vector->lock);
+	ret = vector_sort(&vector->vector, comp);
+	pthread_rwlock_unlock(&vector->lock);
+
+	return ret;
+}
+
+const vector_t* concurrent_vector_read_lock(concurrent_vector_t* vector)
+{
+	pthread_rwlock_rdlock(&vector->lock);
+	return &vector->vector;
+}
+
+void concurrent_vector_read_unlock(concurrent_vector_t* vector)
+{
+	pthread_rwlock_unlock(&vector->lock);
+}
+
+vector_t* concurrent_vector_write_lock(concurrent_vector_t* vector)
+{
+	pthread_rwlock_wrlock(&vector->lock);
+	return &vector->vector;
+}
+
+void concurrent_vector_write_unlock(concurrent_vector_t* vector)
+{
+	pthread_rwlock_unlock(&vector->lock);
+}
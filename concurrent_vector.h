@@ -0,0 +1,154 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file concurrent_vector.h
+@author Tony Pottier
+@brief Thread-safe vector guarded by a reader/writer lock
+
+concurrent_vector_t wraps a vector_t with a pthread rwlock: any number of
+threads can read elements in parallel, while operations modifying the vector
+take the lock exclusively. Since the vector may be reallocated by another
+thread as soon as the lock is released, elements are always copied in and
+out rather than accessed through a pointer.
+
+For bulk work, the read and write lock functions give direct access to the
+underlying vector_t for as long as the lock is held.
+
+Requires POSIX threads: when compiling with -std=c99, also define
+_POSIX_C_SOURCE=200809L.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _CONCURRENT_VECTOR_H_
+#define _CONCURRENT_VECTOR_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "vector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct concurrent_vector_t {
+	vector_t vector;
+	pthread_rwlock_t lock;
+}concurrent_vector_t;
+
+
+/**
+  * @brief initialize an empty concurrent vector with an initial capacity of VECTOR_DEFAULT_INITIAL_SIZE
+  * @param      vector: pointer to the concurrent_vector_t struct to be initialized
+  * @param		size_type: size in bytes of the elements to be stored
+  * @return		0: success
+  *				-1: failure
+  */
+int concurrent_vector_create(concurrent_vector_t* vector, size_t size_type);
+
+/**
+  * @brief initialize an empty concurrent vector with the given initial capacity
+  * @param      vector: pointer to the concurrent_vector_t struct to be initialized
+  * @param		size_type: size in bytes of the elements to be stored
+  * @param		capacity: initial capacity of the vector in number of elements
+  * @return		0: success
+  *				-1: failure
+  */
+int concurrent_vector_create_with(concurrent_vector_t* vector, size_t size_type, size_t capacity);
+
+/**
+  * @brief free all memory held by the vector and its lock. No other thread may be using the vector.
+  * @param  vector: the vector to perform the operation on
+  */
+void concurrent_vector_destroy(concurrent_vector_t* vector);
+
+/**
+  * @brief copy the n th element of the vector. Takes the lock in shared mode.
+  * @param  vector: the vector to perform the operation on
+  * @param  n: the 0-indexed element to read
+  * @param  data: receives a copy of the element
+  * @return 0: success
+  *         -1: n is out of range
+  */
+int concurrent_vector_at(concurrent_vector_t* vector, size_t n, void* data);
+
+/**
+  * @brief overwrite the n th element of the vector
+  * @param  vector: the vector to perform the operation on
+  * @param  n: the 0-indexed element to overwrite
+  * @param  data: reference to the new value
+  * @return 0: success
+  *         -1: n is out of range
+  */
+int concurrent_vector_assign(concurrent_vector_t* vector, size_t n, const void* data);
+
+/**
+  * @brief add an element at the end of the vector
+  * @return 0: success
+  *         -1: failure
+  */
+int concurrent_vector_push_back(concurrent_vector_t* vector, const void* data);
+
+/**
+  * @brief remove the last element of the vector
+  * @param  vector: the vector to perform the operation on
+  * @param  data: receives a copy of the removed element. Can be NULL
+  * @return 0: success
+  *         -1: the vector is empty
+  */
+int concurrent_vector_pop_back(concurrent_vector_t* vector, void* data);
+
+/**
+  * @brief number of elements in the vector. The value may be outdated as soon as it is returned.
+  */
+size_t concurrent_vector_size(concurrent_vector_t* vector);
+
+/**
+  * @brief sort the vector
+  * @return 0: success
+  */
+int concurrent_vector_sort(concurrent_vector_t* vector, int (*comp)(const void*, const void*));
+
+/**
+  * @brief lock the vector in shared mode and return the underlying vector_t, which must only be read
+  * until concurrent_vector_read_unlock is called
+  */
+const vector_t* concurrent_vector_read_lock(concurrent_vector_t* vector);
+
+void concurrent_vector_read_unlock(concurrent_vector_t* vector);
+
+/**
+  * @brief lock the vector in exclusive mode and return the underlying vector_t, which can be freely
+  * used with the vector.h API until concurrent_vector_write_unlock is called
+  */
+vector_t* concurrent_vector_write_lock(concurrent_vector_t* vector);
+
+void concurrent_vector_write_unlock(concurrent_vector_t* vector);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,269 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file epoch.c
+@author Tony Pottier
+@brief Source code for the epoch-based memory reclamation
+
+Thread records are allocated by the domain and chained in a list which only
+ever grows: unregistering a thread only marks its record as free for a later
+registration, so that walking the list never races with a free.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L /* sched_yield */
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include "epoch.h"
+
+typedef struct epoch_retired_t {
+	void* ptr;
+	epoch_destroy_t destroy;
+}epoch_retired_t;
+
+#define _EPOCH_ACTIVE ((uint64_t)1)
+
+
+static size_t _epoch_limbo_free(epoch_limbo_t* limbo)
+{
+	epoch_retired_t* retired = (epoch_retired_t*)limbo->retired.data;
+	size_t count = limbo->retired.size;
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		if (retired[i].destroy) {
+			retired[i].destroy(retired[i].ptr);
+		}
+		else {
+			free(retired[i].ptr);
+		}
+	}
+	/* keep the capacity: the list fills up again at the same pace */
+	limbo->retired.size = 0;
+
+	return count;
+}
+
+/**
+ * @brief advance the global epoch if every thread in a critical section has seen its current value
+ * @return the global epoch after the attempt
+ */
+static uint64_t _epoch_try_advance(epoch_domain_t* domain)
+{
+	uint64_t epoch = __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST);
+	epoch_thread_t* thread;
+	uint64_t state;
+
+	for (thread = __atomic_load_n(&domain->threads, __ATOMIC_ACQUIRE); thread != NULL; thread = thread->next) {
+		state = __atomic_load_n(&thread->state, __ATOMIC_SEQ_CST);
+		if ((state & _EPOCH_ACTIVE) && (state >> 1) != epoch) {
+			return epoch;
+		}
+	}
+
+	/* losing this race means another thread advanced it: fine either way */
+	__atomic_compare_exchange_n(&domain->epoch, &epoch, epoch + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+
+	return __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST);
+}
+
+static int _epoch_thread_init(epoch_thread_t* thread, epoch_domain_t* domain)
+{
+	int i;
+
+	__atomic_store_n(&thread->state, 0, __ATOMIC_RELAXED);
+	thread->nesting = 0;
+	thread->since_collect = 0;
+	thread->domain = domain;
+
+	for (i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+		thread->limbo[i].epoch = 0;
+		if (vector_create(&thread->limbo[i].retired, sizeof(epoch_retired_t)) != 0) {
+			while (i--) {
+				vector_destroy(&thread->limbo[i].retired);
+			}
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+
+int epoch_domain_create(epoch_domain_t* domain, size_t batch_size)
+{
+	if (!domain) return -1;
+
+	domain->epoch = 0;
+	domain->threads = NULL;
+	domain->batch_size = batch_size ? batch_size : EPOCH_DEFAULT_BATCH_SIZE;
+
+	return 0;
+}
+
+void epoch_domain_destroy(epoch_domain_t* domain)
+{
+	epoch_thread_t* thread = domain->threads;
+	epoch_thread_t* next;
+	int i;
+
+	while (thread != NULL) {
+		next = thread->next;
+		if (thread->in_use) {
+			for (i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+				_epoch_limbo_free(&thread->limbo[i]);
+				vector_destroy(&thread->limbo[i].retired);
+			}
+		}
+		free(thread);
+		thread = next;
+	}
+
+	memset(domain, 0x00, sizeof(epoch_domain_t));
+}
+
+epoch_thread_t* epoch_register(epoch_domain_t* domain)
+{
+	epoch_thread_t* thread;
+	int expected;
+
+	/* reuse the record of a thread which unregistered */
+	for (thread = __atomic_load_n(&domain->threads, __ATOMIC_ACQUIRE); thread != NULL; thread = thread->next) {
+		expected = 0;
+		if (__atomic_load_n(&thread->in_use, __ATOMIC_RELAXED) == 0 &&
+			__atomic_compare_exchange_n(&thread->in_use, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			if (_epoch_thread_init(thread, domain) != 0) {
+				__atomic_store_n(&thread->in_use, 0, __ATOMIC_RELEASE);
+				return NULL;
+			}
+			return thread;
+		}
+	}
+
+	thread = (epoch_thread_t*)calloc(1, sizeof(epoch_thread_t));
+	if (!thread) return NULL;
+
+	if (_epoch_thread_init(thread, domain) != 0) {
+		free(thread);
+		return NULL;
+	}
+	thread->in_use = 1;
+
+	thread->next = __atomic_load_n(&domain->threads, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&domain->threads, &thread->next, thread, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+		/* thread->next was refreshed by the failed CAS */
+	}
+
+	return thread;
+}
+
+void epoch_unregister(epoch_thread_t* thread)
+{
+	int i;
+
+	/* the thread is outside of any critical section: the epoch can move on without it */
+	while (epoch_pending(thread)) {
+		if (epoch_collect(thread) == 0) {
+			sched_yield();
+		}
+	}
+
+	for (i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+		vector_destroy(&thread->limbo[i].retired);
+	}
+	__atomic_store_n(&thread->in_use, 0, __ATOMIC_RELEASE);
+}
+
+void epoch_enter(epoch_thread_t* thread)
+{
+	if (thread->nesting++ == 0) {
+		uint64_t epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_RELAXED);
+		/* publish the observed epoch before any shared pointer is read */
+		__atomic_store_n(&thread->state, (epoch << 1) | _EPOCH_ACTIVE, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	}
+}
+
+void epoch_exit(epoch_thread_t* thread)
+{
+	if (--thread->nesting == 0) {
+		__atomic_store_n(&thread->state, thread->state & ~_EPOCH_ACTIVE, __ATOMIC_RELEASE);
+	}
+}
+
+int epoch_retire(epoch_thread_t* thread, void* ptr, epoch_destroy_t destroy)
+{
+	uint64_t epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_SEQ_CST);
+	epoch_limbo_t* limbo = &thread->limbo[epoch % EPOCH_LIMBO_LISTS];
+	epoch_retired_t retired;
+
+	/* the list still holds nodes of epoch - EPOCH_LIMBO_LISTS or older, which are safe by now */
+	if (limbo->epoch != epoch) {
+		_epoch_limbo_free(limbo);
+		limbo->epoch = epoch;
+	}
+
+	retired.ptr = ptr;
+	retired.destroy = destroy;
+	if (vector_push_back(&limbo->retired, &retired) != 0) return -1;
+
+	if (++thread->since_collect >= thread->domain->batch_size) {
+		epoch_collect(thread);
+	}
+
+	return 0;
+}
+
+size_t epoch_collect(epoch_thread_t* thread)
+{
+	uint64_t epoch = _epoch_try_advance(thread->domain);
+	size_t freed = 0;
+	int i;
+
+	thread->since_collect = 0;
+
+	for (i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+		if (thread->limbo[i].retired.size && thread->limbo[i].epoch + EPOCH_GRACE_PERIODS <= epoch) {
+			freed += _epoch_limbo_free(&thread->limbo[i]);
+		}
+	}
+
+	return freed;
+}
+
+size_t epoch_pending(epoch_thread_t* thread)
+{
+	size_t pending = 0;
+	int i;
+
+	for (i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+		pending += thread->limbo[i].retired.size;
+	}
+
+	return pending;
+}
@@ -0,0 +1,179 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file epoch.h
+@author Tony Pottier
+@brief Epoch-based memory reclamation for lock-free containers
+
+In a lock-free container, a node removed by one thread may still be read by
+another thread which loaded a pointer to it just before. Such a node cannot
+be freed right away: it is retired instead, and actually freed once no thread
+can hold a reference to it anymore.
+
+Threads register with an epoch_domain_t and wrap every access to the shared
+container in epoch_enter / epoch_exit. The domain has a global epoch counter
+which can only advance once every thread inside a critical section has seen
+its current value. A node retired during epoch e is freed once the global
+epoch reaches e + 2: by then, every thread that could have seen the node has
+left its critical section.
+
+Retired nodes are kept in per thread lists, one per epoch modulo 3, and freed
+in batches: every batch_size retirements, the thread tries to advance the
+global epoch and frees the lists that became safe.
+
+A thread stuck in a long critical section holds back reclamation for
+everyone: keep critical sections short.
+
+Requires GCC or clang __atomic builtins.
+
+@code{c}
+epoch_thread_t* self = epoch_register(&domain);
+
+epoch_enter(self);
+node = pop_from_lockfree_container();
+epoch_exit(self);
+epoch_retire(self, node, free);
+
+epoch_unregister(self);
+@endcode
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _EPOCH_H_
+#define _EPOCH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "vector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EPOCH_DEFAULT_BATCH_SIZE 64
+
+/* a node retired in epoch e can be freed in epoch e + EPOCH_GRACE_PERIODS */
+#define EPOCH_GRACE_PERIODS 2
+#define EPOCH_LIMBO_LISTS (EPOCH_GRACE_PERIODS + 1)
+
+typedef void (*epoch_destroy_t)(void* ptr);
+
+typedef struct epoch_limbo_t {
+	uint64_t epoch;
+	vector_t retired;	/* of epoch_retired_t */
+}epoch_limbo_t;
+
+typedef struct epoch_thread_t {
+	/* epoch observed when entering the critical section, shifted left by one. Lowest bit: active */
+	uint64_t state;
+	int nesting;
+	int in_use;
+	size_t since_collect;
+	epoch_limbo_t limbo[EPOCH_LIMBO_LISTS];
+	struct epoch_domain_t* domain;
+	struct epoch_thread_t* next;
+}epoch_thread_t;
+
+typedef struct epoch_domain_t {
+	uint64_t epoch;
+	epoch_thread_t* threads;
+	size_t batch_size;
+}epoch_domain_t;
+
+
+/**
+  * @brief initialize a reclamation domain, typically one per container or per group of containers
+  * @param      domain: pointer to the epoch_domain_t struct to be initialized
+  * @param		batch_size: number of retirements between two reclamation attempts of a thread.
+  *				0 selects EPOCH_DEFAULT_BATCH_SIZE
+  * @return		0: success
+  *				-1: failure
+  */
+int epoch_domain_create(epoch_domain_t* domain, size_t batch_size);
+
+/**
+  * @brief free every node still retired and all thread records. No thread may be using the domain.
+  * @param  domain: the domain to perform the operation on
+  */
+void epoch_domain_destroy(epoch_domain_t* domain);
+
+/**
+  * @brief register the calling thread with the domain. Records of unregistered threads are reused.
+  * @param  domain: the domain to register with
+  * @return epoch_thread_t*: the thread record, to be passed to every other call of this thread
+  *         NULL: failure
+  */
+epoch_thread_t* epoch_register(epoch_domain_t* domain);
+
+/**
+  * @brief unregister a thread. Every node it retired is freed first, which may wait for other
+  * threads to leave their critical sections. Must not be called inside a critical section.
+  * @param  thread: the record returned by epoch_register
+  */
+void epoch_unregister(epoch_thread_t* thread);
+
+/**
+  * @brief enter a critical section: no node retired from now on will be freed before epoch_exit.
+  * Critical sections can be nested.
+  * @param  thread: the record returned by epoch_register
+  */
+void epoch_enter(epoch_thread_t* thread);
+
+/**
+  * @brief leave a critical section. Pointers to shared nodes obtained inside must not be used anymore.
+  * @param  thread: the record returned by epoch_register
+  */
+void epoch_exit(epoch_thread_t* thread);
+
+/**
+  * @brief hand over a node which was unlinked from the shared container, to be freed once no
+  * thread can hold a reference to it anymore
+  * @param  thread: the record returned by epoch_register
+  * @param  ptr: the node
+  * @param  destroy: function freeing the node. NULL calls free
+  * @return 0: success
+  *         -1: memory allocation failure, the node was not retired and still belongs to the caller
+  */
+int epoch_retire(epoch_thread_t* thread, void* ptr, epoch_destroy_t destroy);
+
+/**
+  * @brief try to advance the global epoch and free the nodes retired by this thread which became
+  * safe. Called automatically every batch_size retirements.
+  * @param  thread: the record returned by epoch_register
+  * @return number of nodes freed
+  */
+size_t epoch_collect(epoch_thread_t* thread);
+
+/**
+  * @brief number of nodes retired by this thread and not freed yet
+  */
+size_t epoch_pending(epoch_thread_t* thread);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,200 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "work_stealing_deque.h"
+
+/*
+ * A minimal fork/join thread pool: every worker owns a work-stealing deque holding
+ * pointers to tasks. A worker runs the tasks it spawned itself in LIFO order and,
+ * when it runs out of work, steals the oldest task of another worker.
+ */
+
+#define MAX_WORKERS 64
+#define FIB_N       36
+#define FIB_CUTOFF  18   /* below this, fib is computed sequentially */
+
+typedef struct task_t {
+    void (*run)(struct task_t* task);
+    int done;
+} task_t;
+
+typedef struct worker_t {
+    work_stealing_deque_t deque;
+    pthread_t thread;
+    unsigned int seed;
+    struct pool_t* pool;
+} worker_t;
+
+typedef struct pool_t {
+    worker_t workers[MAX_WORKERS];
+    int count;
+    int stop;
+} pool_t;
+
+/* the worker running on the current thread */
+static __thread worker_t* current;
+
+
+static void run_task(task_t* task)
+{
+    task->run(task);
+    __atomic_store_n(&task->done, 1, __ATOMIC_RELEASE);
+}
+
+/* pop a task of our own deque, or steal one from a random victim */
+static task_t* find_task(worker_t* worker)
+{
+    pool_t* pool = worker->pool;
+    task_t* task;
+
+    if (work_stealing_deque_pop(&worker->deque, &task) == 0) {
+        return task;
+    }
+
+    for (int i = 0; i < pool->count; i++) {
+        worker_t* victim = &pool->workers[rand_r(&worker->seed) % pool->count];
+        if (victim != worker && work_stealing_deque_steal(&victim->deque, &task) == 0) {
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+static void spawn(task_t* task)
+{
+    task->done = 0;
+    work_stealing_deque_push(&current->deque, &task);
+}
+
+/* instead of blocking, help running tasks until the awaited one is done */
+static void join(task_t* task)
+{
+    while (!__atomic_load_n(&task->done, __ATOMIC_ACQUIRE)) {
+        task_t* other = find_task(current);
+        if (other) {
+            run_task(other);
+        }
+        else {
+            sched_yield();
+        }
+    }
+}
+
+static void* worker_main(void* arg)
+{
+    worker_t* worker = (worker_t*)arg;
+    current = worker;
+
+    while (!__atomic_load_n(&worker->pool->stop, __ATOMIC_ACQUIRE)) {
+        task_t* task = find_task(worker);
+        if (task) {
+            run_task(task);
+        }
+        else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* the calling thread becomes worker 0 */
+static void pool_create(pool_t* pool, int count)
+{
+    pool->count = count;
+    pool->stop = 0;
+
+    for (int i = 0; i < count; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].seed = (unsigned int)i + 1;
+        work_stealing_deque_create(&pool->workers[i].deque, sizeof(task_t*));
+    }
+    current = &pool->workers[0];
+    for (int i = 1; i < count; i++) {
+        pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]);
+    }
+}
+
+static void pool_destroy(pool_t* pool)
+{
+    __atomic_store_n(&pool->stop, 1, __ATOMIC_RELEASE);
+
+    for (int i = 1; i < pool->count; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (int i = 0; i < pool->count; i++) {
+        work_stealing_deque_destroy(&pool->workers[i].deque);
+    }
+}
+
+
+typedef struct fib_task_t {
+    task_t task;
+    int n;
+    long result;
+} fib_task_t;
+
+static long fib_sequential(int n)
+{
+    return n < 2 ? n : fib_sequential(n - 1) + fib_sequential(n - 2);
+}
+
+static void fib_run(task_t* task)
+{
+    fib_task_t* fib = (fib_task_t*)task;
+
+    if (fib->n < FIB_CUTOFF) {
+        fib->result = fib_sequential(fib->n);
+        return;
+    }
+
+    /* fork fib(n - 1), compute fib(n - 2) ourselves, then join */
+    fib_task_t a = { { fib_run, 0 }, fib->n - 1, 0 };
+    fib_task_t b = { { fib_run, 0 }, fib->n - 2, 0 };
+
+    spawn(&a.task);
+    fib_run(&b.task);
+    join(&a.task);
+
+    fib->result = a.result + b.result;
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main()
+{
+    pool_t pool;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    if (cores > MAX_WORKERS) cores = MAX_WORKERS;
+
+    double start = now();
+    long expected = fib_sequential(FIB_N);
+    double sequential = now() - start;
+    printf("fib(%d) = %ld, sequential: %.3fs\n", FIB_N, expected, sequential);
+
+    for (int workers = 1; workers <= cores; workers <<= 1) {
+        fib_task_t root = { { fib_run, 0 }, FIB_N, 0 };
+
+        pool_create(&pool, workers);
+        start = now();
+        run_task(&root.task);
+        double elapsed = now() - start;
+        pool_destroy(&pool);
+
+        printf("%2d worker(s): fib(%d) = %ld in %.3fs, speedup x%.2f%s\n", workers, FIB_N, root.result,
+            elapsed, sequential / elapsed, root.result == expected ? "" : " WRONG RESULT");
+    }
+
+    return 0;
+}
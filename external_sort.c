@@ -0,0 +1,456 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file external_sort.c
+@author Tony Pottier
+@brief Source code for the external merge sort
+
+Runs are kept in a vector_t of run descriptors used as a queue: a merge pass
+pops fan_in runs from its front and pushes the merged run at its back, so
+every pass merges runs of similar lengths. Temporary runs are read with
+pread at their own offset, and the operating system is told they are read
+sequentially so that it reads ahead of the merge as well.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "external_sort.h"
+#include "vector.h"
+
+/* mkstemp template appended to the temporary directory */
+#define _EXTERNAL_SORT_TEMPLATE "/stdcontainers_sort_XXXXXX"
+
+typedef struct _external_sort_run_t {
+	int fd;
+	uint64_t size;		/* number of records */
+}_external_sort_run_t;
+
+/* a run being merged: its read-ahead buffer and its current record */
+typedef struct _external_sort_source_t {
+	int fd;
+	uint64_t offset;	/* next byte to read from the file */
+	uint64_t remaining;	/* records not loaded yet */
+	uint8_t* buffer;
+	size_t count;		/* records in the buffer */
+	size_t next;		/* index of the current record in the buffer */
+}_external_sort_source_t;
+
+typedef struct _external_sort_reader_t {
+	int fd;
+	vector_t* run;
+	int ret;
+}_external_sort_reader_t;
+
+
+static int _external_sort_write(int fd, const void* buffer, size_t length)
+{
+	const uint8_t* p = (const uint8_t*)buffer;
+
+	while (length) {
+		ssize_t n = write(fd, p, length);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		p += n;
+		length -= (size_t)n;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief read up to length bytes, stopping early only at the end of file
+ * @return number of bytes read, -1 on failure
+ */
+static ssize_t _external_sort_read(int fd, void* buffer, size_t length, off_t offset, int positional)
+{
+	uint8_t* p = (uint8_t*)buffer;
+	size_t total = 0;
+
+	while (total < length) {
+		ssize_t n = positional ? pread(fd, p + total, length - total, offset + (off_t)total) : read(fd, p + total, length - total);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		if (n == 0) break;
+		total += (size_t)n;
+	}
+
+	return (ssize_t)total;
+}
+
+/**
+ * @brief fill the run buffer with as many records as it holds
+ * @return 0: success, run->size is 0 at the end of file
+ *         -1: i/o error or truncated record
+ */
+static int _external_sort_read_run(int fd, vector_t* run)
+{
+	ssize_t n = _external_sort_read(fd, run->data, run->capacity * run->size_type, 0, 0);
+
+	if (n < 0 || (size_t)n % run->size_type != 0) return -1;
+	run->size = (size_t)n / run->size_type;
+
+	return 0;
+}
+
+static void* _external_sort_reader(void* arg)
+{
+	_external_sort_reader_t* reader = (_external_sort_reader_t*)arg;
+	reader->ret = _external_sort_read_run(reader->fd, reader->run);
+	return NULL;
+}
+
+/**
+ * @brief create an anonymous temporary file: it is unlinked right away and disappears once closed
+ * @return the file descriptor, -1 on failure
+ */
+static int _external_sort_temp_file(const external_sort_config_t* config)
+{
+	char path[4096];
+	const char* dir = config->temp_dir;
+	int fd;
+
+	if (!dir) dir = getenv("TMPDIR");
+	if (!dir || !*dir) dir = "/tmp";
+
+	if (snprintf(path, sizeof(path), "%s" _EXTERNAL_SORT_TEMPLATE, dir) >= (int)sizeof(path)) return -1;
+
+	fd = mkstemp(path);
+	if (fd < 0) return -1;
+	unlink(path);
+
+	return fd;
+}
+
+static void _external_sort_close_runs(vector_t* runs)
+{
+	size_t i;
+
+	for (i = 0; i < runs->size; i++) {
+		close(((_external_sort_run_t*)vector_at(runs, (int)i))->fd);
+	}
+	vector_clear(runs);
+}
+
+/**
+ * @brief sort the records of the run buffer and write them to a new temporary run
+ */
+static int _external_sort_spill(vector_t* run, vector_t* runs, int (*comp)(const void*, const void*), const external_sort_config_t* config)
+{
+	_external_sort_run_t spilled;
+
+	vector_sort(run, comp);
+
+	spilled.fd = _external_sort_temp_file(config);
+	if (spilled.fd < 0) return -1;
+	spilled.size = run->size;
+
+	if (_external_sort_write(spilled.fd, run->data, run->size * run->size_type) != 0 || vector_push_back(runs, &spilled) != 0) {
+		close(spilled.fd);
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief split the input in sorted runs. An input fitting in a single run goes straight to out_fd
+ * @return 0: success
+ *         -1: failure
+ */
+static int _external_sort_make_runs(int in_fd, int out_fd, vector_t* runs, int (*comp)(const void*, const void*), const external_sort_config_t* config)
+{
+	vector_t buffers[2];
+	_external_sort_reader_t reader;
+	pthread_t thread;
+	size_t capacity = config->run_size / config->size_type;
+	int current = 0;
+	int reading = 0;
+	int ret = -1;
+	int eof;
+
+	if (capacity == 0) capacity = 1;
+
+	if (vector_create_with(&buffers[0], config->size_type, capacity) != 0) return -1;
+	if (!config->overlap) {
+		memset(&buffers[1], 0x00, sizeof(vector_t));
+	}
+	else if (vector_create_with(&buffers[1], config->size_type, capacity) != 0) {
+		vector_destroy(&buffers[0]);
+		return -1;
+	}
+
+	if (_external_sort_read_run(in_fd, &buffers[current]) != 0) goto done;
+
+	while (buffers[current].size) {
+		eof = buffers[current].size < capacity;
+
+		if (eof && runs->size == 0) {
+			/* the whole input fits in memory */
+			vector_sort(&buffers[current], comp);
+			ret = _external_sort_write(out_fd, buffers[current].data, buffers[current].size * config->size_type);
+			goto done;
+		}
+
+		if (config->overlap && !eof) {
+			reader.fd = in_fd;
+			reader.run = &buffers[!current];
+			reading = pthread_create(&thread, NULL, _external_sort_reader, &reader) == 0;
+		}
+
+		if (_external_sort_spill(&buffers[current], runs, comp, config) != 0) goto done;
+
+		if (eof) break;
+
+		if (reading) {
+			pthread_join(thread, NULL);
+			reading = 0;
+			if (reader.ret != 0) goto done;
+			current = !current;
+		}
+		else if (_external_sort_read_run(in_fd, &buffers[current]) != 0) {
+			goto done;
+		}
+	}
+
+	ret = 0;
+
+done:
+	if (reading) {
+		pthread_join(thread, NULL);
+	}
+	vector_destroy(&buffers[0]);
+	if (config->overlap) {
+		vector_destroy(&buffers[1]);
+	}
+
+	return ret;
+}
+
+static inline uint8_t* _external_sort_current(const _external_sort_source_t* source, size_t size_type)
+{
+	return source->buffer + source->next * size_type;
+}
+
+/**
+ * @brief load the next records of a run in its read-ahead buffer
+ */
+static int _external_sort_refill(_external_sort_source_t* source, size_t buffer_records, size_t size_type)
+{
+	size_t count = buffer_records;
+	ssize_t n;
+
+	if ((uint64_t)count > source->remaining) {
+		count = (size_t)source->remaining;
+	}
+
+	n = _external_sort_read(source->fd, source->buffer, count * size_type, (off_t)source->offset, 1);
+	if (n < 0 || (size_t)n != count * size_type) return -1;
+
+	source->offset += (uint64_t)n;
+	source->remaining -= count;
+	source->count = count;
+	source->next = 0;
+
+	return 0;
+}
+
+/* the heap orders sources by their current record, ties going to the earlier run */
+static inline int _external_sort_less(_external_sort_source_t* sources, int a, int b, size_t size_type, int (*comp)(const void*, const void*))
+{
+	int c = comp(_external_sort_current(&sources[a], size_type), _external_sort_current(&sources[b], size_type));
+	return c < 0 || (c == 0 && a < b);
+}
+
+static void _external_sort_sift_down(int* heap, size_t n, _external_sort_source_t* sources, size_t size_type, int (*comp)(const void*, const void*))
+{
+	size_t root = 0, child;
+	int top = heap[0];
+
+	while ((child = (root << 1) + 1) < n) {
+		if (child + 1 < n && _external_sort_less(sources, heap[child + 1], heap[child], size_type, comp)) child++;
+		if (!_external_sort_less(sources, heap[child], top, size_type, comp)) break;
+		heap[root] = heap[child];
+		root = child;
+	}
+	heap[root] = top;
+}
+
+/**
+ * @brief k-way merge of count runs into out_fd
+ * @return number of records written, -1 on failure
+ */
+static int64_t _external_sort_merge(const _external_sort_run_t* runs, size_t count, int out_fd, int (*comp)(const void*, const void*), const external_sort_config_t* config)
+{
+	size_t size_type = config->size_type;
+	size_t buffer_records = config->io_buffer_size / size_type;
+	_external_sort_source_t* sources;
+	uint8_t* buffers;
+	uint8_t* output;
+	size_t output_count = 0;
+	size_t heap_size = 0;
+	size_t i, j;
+	int64_t written = 0;
+	int* heap;
+
+	if (buffer_records == 0) buffer_records = 1;
+
+	sources = (_external_sort_source_t*)malloc(count * sizeof(_external_sort_source_t));
+	heap = (int*)malloc(count * sizeof(int));
+	/* one read-ahead buffer per run, plus the output buffer */
+	buffers = (uint8_t*)malloc((count + 1) * buffer_records * size_type);
+	if (!sources || !heap || !buffers) {
+		written = -1;
+		goto done;
+	}
+	output = buffers + count * buffer_records * size_type;
+
+	for (i = 0; i < count; i++) {
+		sources[i].fd = runs[i].fd;
+		sources[i].offset = 0;
+		sources[i].remaining = runs[i].size;
+		sources[i].buffer = buffers + i * buffer_records * size_type;
+#ifdef POSIX_FADV_SEQUENTIAL
+		posix_fadvise(runs[i].fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+		if (runs[i].size == 0) continue;
+		if (_external_sort_refill(&sources[i], buffer_records, size_type) != 0) {
+			written = -1;
+			goto done;
+		}
+
+		/* sift up */
+		j = heap_size++;
+		while (j > 0 && _external_sort_less(sources, (int)i, heap[(j - 1) >> 1], size_type, comp)) {
+			heap[j] = heap[(j - 1) >> 1];
+			j = (j - 1) >> 1;
+		}
+		heap[j] = (int)i;
+	}
+
+	while (heap_size) {
+		_external_sort_source_t* source = &sources[heap[0]];
+
+		memcpy(output + output_count * size_type, _external_sort_current(source, size_type), size_type);
+		if (++output_count == buffer_records) {
+			if (_external_sort_write(out_fd, output, output_count * size_type) != 0) {
+				written = -1;
+				goto done;
+			}
+			written += (int64_t)output_count;
+			output_count = 0;
+		}
+
+		if (++source->next == source->count) {
+			if (source->remaining == 0) {
+				/* run exhausted: its place at the root goes to the last leaf */
+				heap[0] = heap[--heap_size];
+				if (heap_size == 0) break;
+			}
+			else if (_external_sort_refill(source, buffer_records, size_type) != 0) {
+				written = -1;
+				goto done;
+			}
+		}
+
+		_external_sort_sift_down(heap, heap_size, sources, size_type, comp);
+	}
+
+	if (_external_sort_write(out_fd, output, output_count * size_type) != 0) {
+		written = -1;
+		goto done;
+	}
+	written += (int64_t)output_count;
+
+done:
+	free(buffers);
+	free(heap);
+	free(sources);
+
+	return written;
+}
+
+
+void external_sort_config_init(external_sort_config_t* config, size_t size_type)
+{
+	config->size_type = size_type;
+	config->run_size = EXTERNAL_SORT_DEFAULT_RUN_SIZE;
+	config->io_buffer_size = EXTERNAL_SORT_DEFAULT_IO_BUFFER_SIZE;
+	config->fan_in = EXTERNAL_SORT_DEFAULT_FAN_IN;
+	config->temp_dir = NULL;
+	config->overlap = 0;
+}
+
+int external_sort(int in_fd, int out_fd, int (*comp)(const void*, const void*), const external_sort_config_t* config)
+{
+	vector_t runs;
+	_external_sort_run_t merged;
+	int64_t written;
+	size_t i;
+	int ret = -1;
+
+	if (!comp || !config || config->size_type == 0 || config->fan_in < 2) return -1;
+
+	if (vector_create(&runs, sizeof(_external_sort_run_t)) != 0) return -1;
+
+	if (_external_sort_make_runs(in_fd, out_fd, &runs, comp, config) != 0) goto done;
+
+	/* intermediate passes: the fan_in oldest runs are merged into a new run at the back of the queue */
+	while (runs.size > config->fan_in) {
+		merged.fd = _external_sort_temp_file(config);
+		if (merged.fd < 0) goto done;
+
+		written = _external_sort_merge((const _external_sort_run_t*)runs.data, config->fan_in, merged.fd, comp, config);
+		if (written < 0 || vector_push_back(&runs, &merged) != 0) {
+			close(merged.fd);
+			goto done;
+		}
+		((_external_sort_run_t*)vector_back(&runs))->size = (uint64_t)written;
+
+		for (i = 0; i < config->fan_in; i++) {
+			close(((_external_sort_run_t*)runs.data)->fd);
+			vector_pop_front(&runs, NULL);
+		}
+	}
+
+	if (runs.size && _external_sort_merge((const _external_sort_run_t*)runs.data, runs.size, out_fd, comp, config) < 0) goto done;
+
+	ret = 0;
+
+done:
+	_external_sort_close_runs(&runs);
+	vector_destroy(&runs);
+
+	return ret;
+}
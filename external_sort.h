@@ -0,0 +1,106 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file external_sort.h
+@author Tony Pottier
+@brief Sorting of fixed size records that do not fit in memory
+
+external_sort reads records of size_type bytes from a file descriptor and
+writes them back sorted to another one, with the same comparator as
+vector_sort. Memory use is bounded by the configuration, not by the input:
+
+1. the input is read in runs filling a vector_t of run_size bytes. Each run
+   is sorted with vector_sort and spilled to an anonymous temporary file in
+   a single large write.
+2. the runs are merged by a k-way merge: a heap holds the current record of
+   every run, and each run is read through its own read-ahead buffer of
+   io_buffer_size bytes. When there are more runs than fan_in, groups of
+   fan_in runs are first merged into longer runs.
+
+An input fitting in a single run is sorted in memory and never touches the
+temporary directory. With overlap set, the next run is read by a second
+thread while the current one is sorted and spilled, at the cost of a second
+run buffer.
+
+external_sort.h requires a POSIX system with threads. Temporary files are
+unlinked as soon as they are created, so they never outlive the process.
+
+@code{c}
+external_sort_config_t config;
+external_sort_config_init(&config, sizeof(record_t));
+config.run_size = 1 << 30;
+config.overlap = 1;
+external_sort(in_fd, out_fd, &record_compare, &config);
+@endcode
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _EXTERNAL_SORT_H_
+#define _EXTERNAL_SORT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EXTERNAL_SORT_DEFAULT_RUN_SIZE (64 << 20)
+#define EXTERNAL_SORT_DEFAULT_IO_BUFFER_SIZE (1 << 20)
+#define EXTERNAL_SORT_DEFAULT_FAN_IN 64
+
+typedef struct external_sort_config_t {
+	size_t size_type;		/* size in bytes of a record */
+	size_t run_size;		/* bytes sorted in memory at once */
+	size_t io_buffer_size;	/* bytes of the read-ahead buffer of each merged run, and of the output buffer */
+	size_t fan_in;			/* maximum number of runs merged at once, at least 2 */
+	const char* temp_dir;	/* directory of the temporary files. NULL: $TMPDIR, or /tmp */
+	int overlap;			/* read the next run on a second thread while sorting the current one */
+}external_sort_config_t;
+
+
+/**
+  * @brief fill a configuration with the default sizes for records of size_type bytes
+  * @param      config: the configuration to initialize
+  * @param		size_type: size in bytes of a record
+  */
+void external_sort_config_init(external_sort_config_t* config, size_t size_type);
+
+/**
+  * @brief sort all the records read from in_fd until the end of file, and write them to out_fd
+  * @param		in_fd: file descriptor open for reading. Its size must be a multiple of size_type
+  * @param		out_fd: file descriptor open for writing, written sequentially
+  * @param		comp: a standard comparator function
+  * @param		config: sizes and options, see external_sort_config_init
+  * @return		0: success
+  *				-1: failure: invalid configuration, truncated record, out of memory or i/o error.
+  *				out_fd may hold part of the output
+  */
+int external_sort(int in_fd, int out_fd, int (*comp)(const void*, const void*), const external_sort_config_t* config);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
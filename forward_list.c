@@ -32,9 +32,10 @@ SOFTWARE.
 #include <string.h>
 #include <stdint.h>
 #include "forward_list.h"
+#include "prefetch.h"
 
 
-inline forward_node_t* _forward_list_node_at(forward_list_t* list, int n)
+static inline forward_node_t* _forward_list_node_at(forward_list_t* list, int n)
 {
 	int i = 0;
 	forward_node_t* node = list->begin;
@@ -45,14 +46,51 @@ inline forward_node_t* _forward_list_node_at(forward_list_t* list, int n)
 	return node;
 }
 
-inline forward_node_t* _forward_node_alloc(forward_list_t* list)
+static inline forward_node_t* _forward_node_alloc(forward_list_t* list)
 {
-	return (forward_node_t*)malloc(sizeof(forward_node_t) + sizeof(uint8_t) * list->size_type);
+	forward_node_t* node = (forward_node_t*)malloc(sizeof(forward_node_t) + sizeof(uint8_t) * list->size_type);
+#ifdef STDCONTAINERS_STATS
+	if (node) {
+		STDCONTAINERS_STATS_INC(list, allocations);
+		STDCONTAINERS_STATS_ADD(list, bytes_allocated, sizeof(forward_node_t) + list->size_type);
+	}
+#endif
+	return node;
+}
+
+/**
+ * @brief detach the node following node, or the first node if node is NULL
+ * @return the detached node, NULL if there is none
+ */
+static inline forward_node_t* _forward_list_unlink_after(forward_list_t* list, forward_node_t* node)
+{
+	forward_node_t* removed = node ? node->next : list->begin;
+	if (!removed) return NULL;
+
+	if (node) {
+		node->next = removed->next;
+	}
+	else {
+		list->begin = removed->next;
+	}
+
+	if (removed == list->end) {
+		list->end = node;
+	}
+
+	if (removed == list->finger) {
+		list->finger = NULL;
+	}
+
+	removed->next = NULL;
+	--list->size;
+
+	return removed;
 }
 
-inline forward_node_t* _forward_node_alloc_and_assign(forward_list_t* list, void* data)
+static inline forward_node_t* _forward_node_alloc_and_assign(forward_list_t* list, void* data)
 {
-	forward_node_t* new_node = (forward_node_t*)malloc(sizeof(forward_node_t) + sizeof(uint8_t) * list->size_type);
+	forward_node_t* new_node = _forward_node_alloc(list);
 	if (!new_node) return NULL; /* memory alloc error */
 
 	memcpy(new_node->data, data, list->size_type);
@@ -60,6 +98,26 @@ inline forward_node_t* _forward_node_alloc_and_assign(forward_list_t* list, void
 	return new_node;
 }
 
+static inline void _forward_node_free(forward_list_t* list, forward_node_t* node)
+{
+	free(node);
+	STDCONTAINERS_STATS_INC(list, frees);
+	(void)list;
+}
+
+static inline void _forward_node_free_chain(forward_list_t* list, forward_node_t* node)
+{
+	forward_node_t* next;
+
+	while (node != NULL) {
+		next = node->next;
+		/* overlap the next node's cache miss with the work done by free */
+		STDCONTAINERS_PREFETCH(next);
+		_forward_node_free(list, node);
+		node = next;
+	}
+}
+
 int forward_list_create(forward_list_t* list, size_t size_type)
 {
 	if (!list) return -1;
@@ -69,6 +127,11 @@ int forward_list_create(forward_list_t* list, size_t size_type)
 	list->size = 0;
 	list->size_type = size_type;
 	list->comparator = NULL;
+	list->finger = NULL;
+	list->finger_enabled = false;
+#ifdef STDCONTAINERS_STATS
+	memset(&list->stats, 0x00, sizeof(container_stats_t));
+#endif
 
 	return 0;
 }
@@ -76,18 +139,12 @@ int forward_list_create(forward_list_t* list, size_t size_type)
 
 void forward_list_clear(forward_list_t* list)
 {
-	forward_node_t* next;
-	forward_node_t* curr = list->begin;
-
-	while (curr != NULL) {
-		next = curr->next;
-		free(curr);
-		curr = next;
-	}
+	_forward_node_free_chain(list, list->begin);
 
 	list->size = 0;
 	list->begin = NULL;
 	list->end = NULL;
+	list->finger = NULL;
 }
 
 
@@ -98,6 +155,61 @@ void forward_list_destroy(forward_list_t* list)
 }
 
 
+/**
+ * @brief order nodes by address, for forward_list_compact
+ */
+static int _forward_list_compare_address(const void* a, const void* b)
+{
+	uintptr_t x = (uintptr_t)*(forward_node_t* const*)a;
+	uintptr_t y = (uintptr_t)*(forward_node_t* const*)b;
+
+	return (x > y) - (x < y);
+}
+
+int forward_list_compact(forward_list_t* list)
+{
+	forward_node_t** nodes;
+	forward_node_t* node;
+	size_t count = (size_t)list->size;
+	size_t i;
+
+	if (count == 0) return 0;
+
+	nodes = (forward_node_t**)malloc(sizeof(forward_node_t*) * count);
+	if (!nodes) return -1;
+
+	/* allocate the whole copy before releasing anything, then link it in address order: see list_compact */
+	for (i = 0; i < count; i++) {
+		nodes[i] = _forward_node_alloc(list);
+		if (!nodes[i]) {
+			while (i > 0) {
+				_forward_node_free(list, nodes[--i]);
+			}
+			free(nodes);
+			return -1;
+		}
+	}
+
+	qsort(nodes, count, sizeof(forward_node_t*), _forward_list_compare_address);
+
+	node = list->begin;
+	for (i = 0; i < count; i++) {
+		memcpy(nodes[i]->data, node->data, list->size_type);
+		nodes[i]->next = i + 1 < count ? nodes[i + 1] : NULL;
+		node = node->next;
+	}
+
+	_forward_node_free_chain(list, list->begin);
+
+	list->begin = nodes[0];
+	list->end = nodes[count - 1];
+	list->finger = NULL;
+
+	free(nodes);
+
+	return 0;
+}
+
 
 void* forward_list_at(forward_list_t* list, int n)
 {
@@ -129,6 +241,31 @@ void* forward_list_back(forward_list_t* list)
 }
 
 
+void forward_list_cursor_init(forward_list_cursor_t* cursor, forward_list_t* list)
+{
+	cursor->node = list->begin;
+}
+
+int forward_list_cursor_next(forward_list_cursor_t* cursor, void** batch, int max)
+{
+	forward_node_t* node = cursor->node;
+	int count = 0;
+
+	while (node != NULL && count < max) {
+		batch[count++] = (void*)node->data;
+		node = node->next;
+	}
+
+	/* get the next batch's first node on its way while the caller processes this one */
+	if (node) {
+		STDCONTAINERS_PREFETCH(node);
+	}
+
+	cursor->node = node;
+
+	return count;
+}
+
 
 int forward_list_assign(forward_list_t* list, int n, const void* data)
 {
@@ -159,6 +296,7 @@ forward_node_t* forward_list_push_front(forward_list_t* list, const void* data)
 	}
 
 	++list->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
 
 	return node;
 }
@@ -182,6 +320,7 @@ forward_node_t* forward_list_push_back(forward_list_t* list, const void* data)
 	}
 
 	++list->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
 
 	return node;
 
@@ -189,22 +328,31 @@ forward_node_t* forward_list_push_back(forward_list_t* list, const void* data)
 
 static forward_node_t* _forward_list_add_ordered_with(forward_list_t* list, const void* data, int (*comp)(const void*, const void*))
 {
+	forward_node_t* new_node;
+	forward_node_t* current;
+	forward_node_t* previous = NULL;
 
 	if (!data) return NULL;
 
 	if (list->size == 0) return forward_list_push_back(list, data);
 
 	/* set node data */
-	forward_node_t* new_node = _forward_node_alloc(list);
+	new_node = _forward_node_alloc(list);
 	if (!new_node) return NULL; /* memory alloc error */
 	memcpy(new_node->data, data, list->size_type);
 
-	/* init position to the list beginning and copy data to the new node*/
-	forward_node_t* current = list->begin;
-	forward_node_t* previous = NULL;
+	comp = STDCONTAINERS_STATS_COMPARATOR(list, comp);
+
+	/* the finger can only be used when data goes after it: there is no way back */
+	if (list->finger_enabled && list->finger && comp(&(list->finger->data[0]), data) < 0) {
+		previous = list->finger;
+	}
+	current = previous ? previous->next : list->begin;
 
 	/* find spot in list to add the new element */
-	while (current != NULL && comp((&(current->data[0])), data) < 0) {
+	while (current != NULL) {
+		STDCONTAINERS_PREFETCH(current->next);
+		if (comp((&(current->data[0])), data) >= 0) break;
 		previous = current;
 		current = current->next;
 	}
@@ -224,7 +372,12 @@ static forward_node_t* _forward_list_add_ordered_with(forward_list_t* list, cons
 		previous->next = new_node;
 	}
 
+	if (list->finger_enabled) {
+		list->finger = previous;
+	}
+
 	++list->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
 
 	return new_node;
 
@@ -256,10 +409,158 @@ forward_node_t* forward_list_insert_after(forward_list_t* list, forward_node_t*
 		new_node->next = node->next;
 		node->next = new_node;
 
+		++list->size;
+		STDCONTAINERS_STATS_MAX_SIZE(list);
+
 		return new_node;
 	}
 }
 
+void* forward_list_emplace_front(forward_list_t* list)
+{
+	forward_node_t* node = _forward_node_alloc(list);
+	if (!node) return NULL; /* memory alloc error */
+
+	node->next = list->begin;
+	list->begin = node;
+	if (!list->end) {
+		list->end = node;
+	}
+
+	++list->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	return node->data;
+}
+
+void* forward_list_emplace_back(forward_list_t* list)
+{
+	forward_node_t* node = _forward_node_alloc(list);
+	if (!node) return NULL; /* memory alloc error */
+
+	node->next = NULL;
+	if (list->end) {
+		list->end->next = node;
+	}
+	else {
+		list->begin = node;
+	}
+	list->end = node;
+
+	++list->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	return node->data;
+}
+
+
+int forward_list_pop_front(forward_list_t* list, void* data)
+{
+	return forward_list_erase_after(list, NULL, data);
+}
+
+int forward_list_remove_if(forward_list_t* list, int (*pred)(const void* data, void* ctx), void* ctx, forward_list_t* removed)
+{
+	forward_node_t* node = list->begin;
+	forward_node_t** link = &list->begin;
+	forward_node_t* next;
+	forward_node_t* kept = NULL;
+	forward_node_t* first = NULL;
+	forward_node_t* last = NULL;
+	int count = 0;
+
+	if (removed && (removed == list || removed->size_type != list->size_type)) return -1;
+
+	while (node) {
+		next = node->next;
+		STDCONTAINERS_PREFETCH(next);
+
+		if (pred(node->data, ctx)) {
+			if (removed) {
+				/* chain the removed nodes together, to be handed over at the end */
+				if (last) {
+					last->next = node;
+				}
+				else {
+					first = node;
+				}
+				last = node;
+			}
+			else {
+				/* released right away, while the node is still in cache */
+				_forward_node_free(list, node);
+			}
+			count++;
+		}
+		else {
+			/* kept nodes are only written to when a removed node was in front of them */
+			if (*link != node) {
+				*link = node;
+			}
+			link = &node->next;
+			kept = node;
+		}
+
+		node = next;
+	}
+
+	if (count == 0) return 0;
+
+	*link = NULL;
+	list->end = kept;
+	list->size -= count;
+	list->finger = NULL;
+
+	if (removed) {
+		last->next = NULL;
+		if (removed->end) {
+			removed->end->next = first;
+		}
+		else {
+			removed->begin = first;
+		}
+		removed->end = last;
+		removed->size += count;
+		STDCONTAINERS_STATS_MAX_SIZE(removed);
+	}
+
+	return count;
+}
+
+int forward_list_erase(forward_list_t* list, int n)
+{
+	if (n < 0 || n >= list->size) return -1;
+
+	return forward_list_erase_after(list, n ? _forward_list_node_at(list, n - 1) : NULL, NULL);
+}
+
+int forward_list_erase_after(forward_list_t* list, forward_node_t* node, void* data)
+{
+	forward_node_t* removed = _forward_list_unlink_after(list, node);
+	if (!removed) return -1;
+
+	/* NULL can be passed as data. In that case value isn't sent back to caller */
+	if (data) {
+		memcpy(data, removed->data, list->size_type);
+	}
+
+	_forward_node_free(list, removed);
+
+	return 0;
+}
+
+forward_node_t* forward_list_pop_front_node(forward_list_t* list)
+{
+	return _forward_list_unlink_after(list, NULL);
+}
+
+void forward_list_release_node(forward_list_t* list, forward_node_t* node)
+{
+	if (node) {
+		_forward_node_free(list, node);
+	}
+}
+
 
 int forward_list_set_comparator(forward_list_t* list, int (*comp)(const void*, const void*))
 {
@@ -267,14 +568,24 @@ int forward_list_set_comparator(forward_list_t* list, int (*comp)(const void*, c
 	return 0;
 }
 
+int forward_list_set_finger(forward_list_t* list, bool enabled)
+{
+	list->finger_enabled = enabled;
+	list->finger = NULL;
+	return 0;
+}
+
 forward_node_t* forward_list_contains(forward_list_t* list, const void* data)
 {
 	if (list->comparator) {
 
+		int (*comp)(const void*, const void*) = STDCONTAINERS_STATS_COMPARATOR(list, list->comparator);
 		forward_node_t* node = list->begin;
 
 		while (node) {
-			if (list->comparator(&(node->data[0]), data) == 0) {
+			/* next node is on its way while the comparator runs */
+			STDCONTAINERS_PREFETCH(node->next);
+			if (comp(&(node->data[0]), data) == 0) {
 				return node;
 			}
 			node = node->next;
@@ -288,6 +599,282 @@ forward_node_t* forward_list_contains(forward_list_t* list, const void* data)
 }
 
 
+/**
+ * @brief merge two sorted chains of nodes, the forward_node_t version of list.c's list_merge_lists
+ */
+static forward_node_t* _forward_list_merge_lists(forward_node_t* list1, forward_node_t* list2, int (*comp)(const void*, const void*))
+{
+	forward_node_t* head = NULL;
+	forward_node_t** p_head = &head;
+
+	if (list1 == NULL) {
+		return list2;
+	}
+
+	if (list2 == NULL) {
+		return list1;
+	}
+
+	for (;;) {
+		if (comp(&(list2->data[0]), &(list1->data[0])) < 0) {
+			*p_head = list2;
+			list2 = *(p_head = &(list2->next));
+			if (list2 == NULL) {
+				*p_head = list1;
+				break;
+			}
+		}
+		else {
+			*p_head = list1;
+			list1 = *(p_head = &(list1->next));
+			if (list1 == NULL) {
+				*p_head = list2;
+				break;
+			}
+		}
+	}
+	return head;
+}
+
+int forward_list_splice_after(forward_list_t* list, forward_node_t* position, forward_list_t* other)
+{
+	if (list == other || list->size_type != other->size_type) return -1;
+	if (other->begin == NULL) return 0;
+
+	if (position) {
+		other->end->next = position->next;
+		position->next = other->begin;
+		if (position == list->end) {
+			list->end = other->end;
+		}
+	}
+	else {
+		other->end->next = list->begin;
+		list->begin = other->begin;
+		if (list->end == NULL) {
+			list->end = other->end;
+		}
+	}
+
+	list->size += other->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	other->begin = NULL;
+	other->end = NULL;
+	other->size = 0;
+	other->finger = NULL;
+
+	return 0;
+}
+
+int forward_list_splice_range_after(forward_list_t* list, forward_node_t* position, forward_list_t* other, forward_node_t* before_first, forward_node_t* last)
+{
+	forward_node_t* first = before_first ? before_first->next : other->begin;
+	forward_node_t* node;
+	int count = 1;
+
+	if (list->size_type != other->size_type || !first || !last) return -1;
+
+	if (list != other) {
+		for (node = first; node != last; node = node->next) {
+			count++;
+		}
+	}
+
+	/* unlink from other */
+	if (before_first) {
+		before_first->next = last->next;
+	}
+	else {
+		other->begin = last->next;
+	}
+	if (other->end == last) {
+		other->end = before_first;
+	}
+	other->finger = NULL;
+
+	/* link into list */
+	if (position) {
+		last->next = position->next;
+		position->next = first;
+		if (list->end == position) {
+			list->end = last;
+		}
+	}
+	else {
+		last->next = list->begin;
+		list->begin = first;
+		if (list->end == NULL) {
+			list->end = last;
+		}
+	}
+
+	if (list != other) {
+		other->size -= count;
+		list->size += count;
+		STDCONTAINERS_STATS_MAX_SIZE(list);
+	}
+
+	return 0;
+}
+
+int forward_list_split_after(forward_list_t* list, forward_node_t* node, forward_list_t* tail)
+{
+	forward_node_t* first = node ? node->next : list->begin;
+	forward_node_t* last = list->end;
+	forward_node_t* curr;
+	int count = 0;
+
+	if (list == tail || list->size_type != tail->size_type) return -1;
+	if (first == NULL) return 0;
+
+	for (curr = first; curr != NULL; curr = curr->next) {
+		count++;
+	}
+
+	if (node) {
+		node->next = NULL;
+	}
+	else {
+		list->begin = NULL;
+	}
+	list->end = node;
+	list->size -= count;
+	list->finger = NULL;
+
+	if (tail->end) {
+		tail->end->next = first;
+	}
+	else {
+		tail->begin = first;
+	}
+	tail->end = last;
+	tail->size += count;
+	STDCONTAINERS_STATS_MAX_SIZE(tail);
+
+	return 0;
+}
+
+int forward_list_merge_sorted_with(forward_list_t* list, forward_list_t* other, int (*comp)(const void*, const void*))
+{
+	forward_node_t* node;
+
+	if (list == other || list->size_type != other->size_type || !comp) return -1;
+	if (other->begin == NULL) return 0;
+
+	comp = STDCONTAINERS_STATS_COMPARATOR(list, comp);
+
+	/* list comes first so that equal elements keep list's ones in front */
+	node = _forward_list_merge_lists(list->begin, other->begin, comp);
+	list->begin = node;
+
+	/* find the list's new last element */
+	while (node->next != NULL) {
+		node = node->next;
+	}
+	list->end = node;
+	list->size += other->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	other->begin = NULL;
+	other->end = NULL;
+	other->size = 0;
+	other->finger = NULL;
+
+	return 0;
+}
+
+int forward_list_merge_sorted(forward_list_t* list, forward_list_t* other)
+{
+	return forward_list_merge_sorted_with(list, other, list->comparator);
+}
+
+
+#define MERGE_SORT_BOTTOM_UP_NUMLISTS 32
+
+/**
+ * @brief the forward_node_t version of list.c's list_merge_sort_bottom_up: only next links to
+ * relink, and the last node is found again once sorted
+ * @see https://en.wikipedia.org/wiki/Merge_sort#Bottom-up_implementation_using_lists
+ */
+static int _forward_list_merge_sort_bottom_up(forward_list_t* list, int (*comp)(const void*, const void*))
+{
+	forward_node_t* lists[MERGE_SORT_BOTTOM_UP_NUMLISTS];
+	forward_node_t* node;
+	forward_node_t* next;
+	int i;
+
+	if (!comp) return -1;
+
+	/* list is empty? there's nothing to do */
+	if (list->begin == NULL) {
+		return 0;
+	}
+
+	comp = STDCONTAINERS_STATS_COMPARATOR(list, comp);
+
+	memset(lists, 0, sizeof(lists));
+
+	node = list->begin;
+	while (node != NULL) {
+		next = node->next;
+		node->next = NULL;
+		for (i = 0; (i < MERGE_SORT_BOTTOM_UP_NUMLISTS) && (lists[i] != NULL); i++) {
+			node = _forward_list_merge_lists(lists[i], node, comp);
+			lists[i] = NULL;
+		}
+		if (i == MERGE_SORT_BOTTOM_UP_NUMLISTS) {
+			i--;
+		}
+
+		lists[i] = node;
+		node = next;
+	}
+	node = NULL;
+
+	for (i = 0; i < MERGE_SORT_BOTTOM_UP_NUMLISTS; i++) {
+		node = _forward_list_merge_lists(lists[i], node, comp);
+	}
+
+	list->begin = node;
 
+	/* find the list's new last element */
+	while (node->next != NULL) {
+		node = node->next;
+	}
+	list->end = node;
+
+	return 0;
+}
+
+int forward_list_sort(forward_list_t* list)
+{
+	return _forward_list_merge_sort_bottom_up(list, list->comparator);
+}
 
+int forward_list_sort_with(forward_list_t* list, int (*comp)(const void*, const void*))
+{
+	return _forward_list_merge_sort_bottom_up(list, comp);
+}
+
+int forward_list_get_stats(const forward_list_t* list, container_stats_t* stats)
+{
+#ifdef STDCONTAINERS_STATS
+	memcpy(stats, &list->stats, sizeof(container_stats_t));
+	return 0;
+#else
+	(void)list;
+	memset(stats, 0x00, sizeof(container_stats_t));
+	return -1;
+#endif
+}
 
+void forward_list_reset_stats(forward_list_t* list)
+{
+#ifdef STDCONTAINERS_STATS
+	memset(&list->stats, 0x00, sizeof(container_stats_t));
+	list->stats.max_size = (uint64_t)list->size;
+#else
+	(void)list;
+#endif
+}
@@ -32,6 +32,8 @@ SOFTWARE.
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include "stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -57,6 +59,11 @@ typedef struct forward_list_t {
     forward_node_t* begin;
     forward_node_t* end;
     int (*comparator)(const void*, const void*);
+    forward_node_t* finger; /* finger mode: node after which the last forward_list_add_ordered inserted */
+    bool finger_enabled;
+#ifdef STDCONTAINERS_STATS
+    container_stats_t stats;
+#endif
 }forward_list_t;
 
 
@@ -68,6 +75,18 @@ int forward_list_create(forward_list_t* list, size_t size_type);
 void forward_list_clear(forward_list_t* list);
 void forward_list_destroy(forward_list_t* list);
 
+/**
+  * @brief reallocate every node of the list and link them by increasing address
+  * @note nodes are still allocated one by one: they are back to back only where malloc hands out
+  * contiguous memory, which it rarely does while it holds holes of the node size left by earlier frees
+  * @param  list: the list to compact
+  * @return 0: success
+  *         -1: failure. The list is left untouched
+  * @warning every forward_node_t* and data pointer previously obtained from the list is invalidated
+  * @see list_compact
+  */
+int forward_list_compact(forward_list_t* list);
+
 /*********************/
 /* element access    */
 /*********************/
@@ -77,6 +96,34 @@ void* forward_list_front(forward_list_t* list);
 void* forward_list_back(forward_list_t* list);
 
 
+/*********************/
+/* iteration         */
+/*********************/
+
+#define FORWARD_LIST_CURSOR_BATCH_SIZE 64
+
+typedef struct forward_list_cursor_t {
+    forward_node_t* node;
+}forward_list_cursor_t;
+
+/**
+  * @brief position a cursor on the first element of the given list
+  * @param  cursor: the cursor to initialize
+  * @param  list: the list to iterate over
+  */
+void forward_list_cursor_init(forward_list_cursor_t* cursor, forward_list_t* list);
+
+/**
+  * @brief fetch the next batch of elements of the list
+  * @param  cursor: the cursor to advance
+  * @param  batch: array receiving up to max pointers to data
+  * @param  max: capacity of batch, typically FORWARD_LIST_CURSOR_BATCH_SIZE
+  * @return number of pointers written to batch. 0 once the end of the list is reached
+  * @see list_cursor_next
+  */
+int forward_list_cursor_next(forward_list_cursor_t* cursor, void** batch, int max);
+
+
 /*********************/
 /* insertion         */
 /*********************/
@@ -87,6 +134,16 @@ forward_node_t* forward_list_push_back(forward_list_t* list, const void* data);
 forward_node_t* forward_list_add_ordered(forward_list_t* list, const void* data);
 forward_node_t* forward_list_insert_after(forward_list_t*, forward_node_t* node, void* data);
 
+/**
+  * @brief add an uninitialized element at the beginning or at the end of the list
+  * @param  list: the list to add the item to
+  * @return void*: pointer to the new element's data, to be filled in place by the caller
+  *         NULL: failure
+  * @see list_emplace_back
+  */
+void* forward_list_emplace_front(forward_list_t* list);
+void* forward_list_emplace_back(forward_list_t* list);
+
 
 /*********************/
 /* deletion          */
@@ -94,17 +151,144 @@ forward_node_t* forward_list_insert_after(forward_list_t*, forward_node_t* node,
 
 int forward_list_pop_front(forward_list_t* list, void* data);
 int forward_list_erase(forward_list_t*, int n);
+
+/**
+  * @brief remove the node following node
+  * @param  node: node of list. NULL removes the first element
+  * @param  data: optional, where the removed value is copied
+  * @return 0: success
+  *         -1: failure, node is the last node of the list
+  */
 int forward_list_erase_after(forward_list_t*, forward_node_t* node, void* data);
 
+/**
+  * @brief detach the first node of the list without copying nor freeing it
+  * @return forward_node_t*: the detached node, whose data can be read in place
+  *         NULL: the list is empty
+  * @warning the node must be given back with forward_list_release_node once done with it
+  */
+forward_node_t* forward_list_pop_front_node(forward_list_t* list);
+
+/**
+  * @brief remove all elements for which pred returns non zero, in a single traversal
+  * @param  removed: optional list receiving the removed nodes, appended in order. When NULL the
+  *         removed nodes are freed during the traversal
+  * @return the number of elements removed
+  *         -1: failure, removed is list itself or does not hold the same size_type
+  * @see list_remove_if
+  */
+int forward_list_remove_if(forward_list_t* list, int (*pred)(const void* data, void* ctx), void* ctx, forward_list_t* removed);
+void forward_list_release_node(forward_list_t* list, forward_node_t* node);
+
+
+/*********************/
+/* splicing          */
+/*********************/
+
+/**
+  * @brief move all elements of other into list, right after position. No node is allocated or copied.
+  * @param  list: the list receiving the elements
+  * @param  position: node of list after which the elements are inserted. NULL inserts them at the front
+  * @param  other: the list giving away its elements. It is left empty
+  * @return 0: success
+  *         -1: failure, e.g. the lists do not hold the same size_type
+  * @note complexity is O(1)
+  */
+int forward_list_splice_after(forward_list_t* list, forward_node_t* position, forward_list_t* other);
+
+/**
+  * @brief move the nodes following before_first up to last (included) from other into list, right after position
+  * @param  list: the list receiving the elements
+  * @param  position: node of list after which the elements are inserted. NULL inserts them at the front
+  * @param  other: the list giving away the elements. It can be list itself
+  * @param  before_first: node preceding the first node to be moved. NULL moves from the front of other
+  * @param  last: last node to be moved
+  * @return 0: success
+  *         -1: failure
+  * @note complexity is O(number of moved nodes), O(1) when moving nodes within the same list
+  */
+int forward_list_splice_range_after(forward_list_t* list, forward_node_t* position, forward_list_t* other, forward_node_t* before_first, forward_node_t* last);
+
+/**
+  * @brief split the list in two: all the nodes following node are moved to the end of tail
+  * @param  list: the list to split
+  * @param  node: last node kept in list. NULL moves the entire list
+  * @param  tail: the list receiving the nodes, typically an empty list
+  * @return 0: success
+  *         -1: failure
+  * @note complexity is O(number of moved nodes)
+  */
+int forward_list_split_after(forward_list_t* list, forward_node_t* node, forward_list_t* tail);
+
+/**
+  * @brief merge two sorted lists. All elements of other are moved into list, which stays sorted
+  * @param  list: a sorted list receiving the elements
+  * @param  other: a sorted list giving away its elements. It is left empty
+  * @return 0: success
+  *         -1: failure
+  * @warning forward_list_set_comparator must be called on list prior to calling forward_list_merge_sorted
+  * @see list_merge_sorted
+  */
+int forward_list_merge_sorted(forward_list_t* list, forward_list_t* other);
+int forward_list_merge_sorted_with(forward_list_t* list, forward_list_t* other, int (*comp)(const void*, const void*));
+
+/**
+  * @brief sorts the given list according to its internal comparator. The sort is stable
+  * @param   list: the list to sort
+  * @warning forward_list_set_comparator must be called prior to calling forward_list_sort
+  * @return  0: success
+  *          -1: failure
+  * @note in place bottom-up merge sort: nodes are relinked, never copied nor reallocated
+  * @see list_sort
+  */
+int forward_list_sort(forward_list_t* list);
+
+/**
+  * @brief sorts the given list according to the comparator passed as argument
+  * @param   list: the list to sort
+  * @param   comp: a standard comparator function
+  * @return  0: success
+  *          -1: failure
+  */
+int forward_list_sort_with(forward_list_t* list, int (*comp)(const void*, const void*));
+
 
 /*********************/
 /* compare           */
 /*********************/
 
 int forward_list_set_comparator(forward_list_t* list, int (*comp)(const void*, const void*));
+
+/**
+  * @brief turn finger mode on or off: forward_list_add_ordered starts its search from where the previous
+  * one inserted instead of the list's beginning, so nearly increasing values are inserted in O(1) amortized
+  * @param  list: the list to perform the operation on
+  * @param  enabled: true to turn finger mode on, false to turn it off
+  * @return 0: success
+  * @note a forward list cannot walk back: the finger is kept on the node before the last insertion so
+  * that small local disorder still benefits, but a value smaller than that node is searched from the
+  * beginning of the list. The finger is dropped when its node leaves the list, and by clear, compact,
+  * remove_if, split and splice
+  * @see list_set_finger
+  */
+int forward_list_set_finger(forward_list_t* list, bool enabled);
 forward_node_t* forward_list_contains(forward_list_t* list, const void* data);
 
 
+/*********************/
+/* statistics        */
+/*********************/
+
+/**
+  * @brief copy the counters recorded by the list since its creation or the last forward_list_reset_stats
+  * @return 0: success
+  *         -1: the library was compiled without STDCONTAINERS_STATS. stats is zero filled
+  * @see stats.h
+  */
+int forward_list_get_stats(const forward_list_t* list, container_stats_t* stats);
+void forward_list_reset_stats(forward_list_t* list);
+
+
 
 
 #ifdef __cplusplus
@@ -31,6 +31,89 @@ SOFTWARE.
 #include <string.h>
 #include <stdint.h>
 #include "list.h"
+#include "prefetch.h"
+
+static inline node_t* _list_node_alloc(list_t* list)
+{
+	node_t* node = (node_t*)malloc(sizeof(node_t) + sizeof(uint8_t) * list->size_type);
+#ifdef STDCONTAINERS_STATS
+	if (node) {
+		STDCONTAINERS_STATS_INC(list, allocations);
+		STDCONTAINERS_STATS_ADD(list, bytes_allocated, sizeof(node_t) + list->size_type);
+	}
+#endif
+	return node;
+}
+
+static inline void _list_node_free(list_t* list, node_t* node)
+{
+	free(node);
+	STDCONTAINERS_STATS_INC(list, frees);
+	(void)list;
+}
+
+static inline void _list_node_free_chain(list_t* list, node_t* node)
+{
+	node_t* next;
+
+	while (node != NULL) {
+		next = node->next;
+		/* overlap the next node's cache miss with the work done by free */
+		STDCONTAINERS_PREFETCH(next);
+		_list_node_free(list, node);
+		node = next;
+	}
+}
+
+/**
+ * @brief detach the chain first..last from the list without touching its size
+ */
+static inline void _list_unlink_range(list_t* list, node_t* first, node_t* last)
+{
+	/* a single node is easy to check, a range could hold the finger anywhere */
+	if (first != last || list->finger == first) {
+		list->finger = NULL;
+	}
+
+	if (first->previous) {
+		first->previous->next = last->next;
+	}
+	else {
+		list->begin = last->next;
+	}
+
+	if (last->next) {
+		last->next->previous = first->previous;
+	}
+	else {
+		list->end = first->previous;
+	}
+}
+
+/**
+ * @brief attach the chain first..last before position, or at the end of the list if position is NULL
+ */
+static inline void _list_link_range_before(list_t* list, node_t* position, node_t* first, node_t* last)
+{
+	node_t* previous = position ? position->previous : list->end;
+
+	first->previous = previous;
+	last->next = position;
+
+	if (previous) {
+		previous->next = first;
+	}
+	else {
+		list->begin = first;
+	}
+
+	if (position) {
+		position->previous = last;
+	}
+	else {
+		list->end = last;
+	}
+}
 
 int list_create(list_t* list, size_t size_type)
 {
@@ -41,24 +124,23 @@ int list_create(list_t* list, size_t size_type)
 	list->size = 0;
 	list->size_type = size_type;
 	list->comparator = NULL;
+	list->finger = NULL;
+	list->finger_enabled = false;
+#ifdef STDCONTAINERS_STATS
+	memset(&list->stats, 0x00, sizeof(container_stats_t));
+#endif
 
 	return 0;
 }
 
 void list_clear(list_t* list)
 {
-	node_t* next;
-	node_t* curr = list->begin;
-
-	while (curr != NULL) {
-		next = curr->next;
-		free(curr);
-		curr = next;
-	}
+	_list_node_free_chain(list, list->begin);
 
 	list->size = 0;
 	list->begin = NULL;
 	list->end = NULL;
+	list->finger = NULL;
 }
 
 void list_destroy(list_t* list)
@@ -67,19 +149,129 @@ void list_destroy(list_t* list)
 	memset(list, 0x00, sizeof(list_t));
 }
 
+/**
+ * @brief order nodes by address, for list_compact
+ */
+static int _list_compare_address(const void* a, const void* b)
+{
+	uintptr_t x = (uintptr_t)*(node_t* const*)a;
+	uintptr_t y = (uintptr_t)*(node_t* const*)b;
+
+	return (x > y) - (x < y);
+}
+
+int list_compact(list_t* list)
+{
+	node_t** nodes;
+	node_t* node;
+	size_t count = (size_t)list->size;
+	size_t i;
+
+	if (count == 0) return 0;
+
+	nodes = (node_t**)malloc(sizeof(node_t*) * count);
+	if (!nodes) return -1;
+
+	/* allocate the whole copy before releasing anything, so that no new node takes the place of an old one */
+	for (i = 0; i < count; i++) {
+		nodes[i] = _list_node_alloc(list);
+		if (!nodes[i]) {
+			while (i > 0) {
+				_list_node_free(list, nodes[--i]);
+			}
+			free(nodes);
+			return -1;
+		}
+	}
+
+	/* malloc serves same sized requests from the holes left by earlier frees first, so the copy is
+	rarely contiguous: link it in address order so that iteration at least walks memory forward */
+	qsort(nodes, count, sizeof(node_t*), _list_compare_address);
+
+	node = list->begin;
+	for (i = 0; i < count; i++) {
+		memcpy(nodes[i]->data, node->data, list->size_type);
+		nodes[i]->previous = i > 0 ? nodes[i - 1] : NULL;
+		nodes[i]->next = i + 1 < count ? nodes[i + 1] : NULL;
+		node = node->next;
+	}
+
+	_list_node_free_chain(list, list->begin);
+
+	list->begin = nodes[0];
+	list->end = nodes[count - 1];
+	list->finger = NULL;
+
+	free(nodes);
+
+	return 0;
+}
+
+
+/**
+ * @brief find the n th node, walking from the closest end of the list. n must be a valid index.
+ */
+static inline node_t* _list_node_at(list_t* list, int n)
+{
+	node_t* curr;
+	int i;
+
+	/* a pure pointer chase cannot be prefetched ahead: walk from the closest end instead */
+	if (n <= (list->size >> 1)) {
+		curr = list->begin;
+		for (i = 0; i != n; i++) {
+			curr = curr->next;
+		}
+	}
+	else {
+		curr = list->end;
+		for (i = list->size - 1; i != n; i--) {
+			curr = curr->previous;
+		}
+	}
+
+	return curr;
+}
 
 void* list_at(list_t* list, int n)
 {
-	if (n >= list->size) return NULL;
+	if (n < 0 || n >= list->size) return NULL;
+
+	return (void*)_list_node_at(list, n)->data;
+}
+
+int list_assign(list_t* list, int n, const void* data)
+{
+	if (n < 0 || n >= list->size) return -1;
+
+	memcpy(_list_node_at(list, n)->data, data, list->size_type);
+
+	return 0;
+}
+
+void list_cursor_init(list_cursor_t* cursor, list_t* list)
+{
+	cursor->node = list->begin;
+}
+
+int list_cursor_next(list_cursor_t* cursor, void** batch, int max)
+{
+	node_t* node = cursor->node;
+	int count = 0;
+
+	while (node != NULL && count < max) {
+		batch[count++] = (void*)node->data;
+		node = node->next;
+	}
 
-	int i = 0;
-	node_t* curr = list->begin;
-	while (i != n) {
-		curr = curr->next;
-		i++;
+	/* get the next batch's first node on its way while the caller processes this one */
+	if (node) {
+		STDCONTAINERS_PREFETCH(node);
 	}
 
-	return (void*)curr->data;
+	cursor->node = node;
+
+	return count;
 }
 
 int list_set_comparator(list_t* list, int (*comp)(const void*, const void*))
@@ -91,7 +283,7 @@ int list_set_comparator(list_t* list, int (*comp)(const void*, const void*))
 
 node_t* list_push_back(list_t* list, const void* data)
 {
-	node_t* node = (node_t*)malloc(sizeof(node_t) + sizeof(uint8_t) * list->size_type);
+	node_t* node = _list_node_alloc(list);
 	if (!node) return NULL; /* memory alloc error */
 
 	memcpy(node->data, data, list->size_type);
@@ -109,6 +301,7 @@ node_t* list_push_back(list_t* list, const void* data)
 	}
 
 	list->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
 
 	return node;
 }
@@ -116,7 +309,7 @@ node_t* list_push_back(list_t* list, const void* data)
 
 node_t* list_push_front(list_t* list, const void* data)
 {
-	node_t* node = (node_t*)malloc(sizeof(node_t) + sizeof(uint8_t) * list->size_type);
+	node_t* node = _list_node_alloc(list);
 	if (!node) return NULL; /* memory alloc error */
 
 	memcpy(node->data, data, list->size_type);
@@ -135,6 +328,7 @@ node_t* list_push_front(list_t* list, const void* data)
 	}
 
 	list->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
 
 	return node;
 }
@@ -144,6 +338,32 @@ node_t* list_push_front(list_t* list, const void* data)
 
 
 
+void* list_emplace_back(list_t* list)
+{
+	node_t* node = _list_node_alloc(list);
+	if (!node) return NULL; /* memory alloc error */
+
+	_list_link_range_before(list, NULL, node, node);
+	list->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	return node->data;
+}
+
+void* list_emplace_front(list_t* list)
+{
+	node_t* node = _list_node_alloc(list);
+	if (!node) return NULL; /* memory alloc error */
+
+	_list_link_range_before(list, list->begin, node, node);
+	list->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	return node->data;
+}
+
+
+
 int list_pop_front(list_t* list, void* data)
 {
 	if (list->begin) {
@@ -163,7 +383,10 @@ int list_pop_front(list_t* list, void* data)
 			list->begin->previous = NULL;
 		}
 
-		free(first);
+		if (list->finger == first) {
+			list->finger = NULL;
+		}
+		_list_node_free(list, first);
 		list->size--;
 
 		return 0;
@@ -175,6 +398,43 @@ int list_pop_front(list_t* list, void* data)
 
 
 
+node_t* list_pop_front_node(list_t* list)
+{
+	node_t* node = list->begin;
+	if (!node) return NULL;
+
+	_list_unlink_range(list, node, node);
+	list->size--;
+
+	node->previous = NULL;
+	node->next = NULL;
+
+	return node;
+}
+
+node_t* list_pop_back_node(list_t* list)
+{
+	node_t* node = list->end;
+	if (!node) return NULL;
+
+	_list_unlink_range(list, node, node);
+	list->size--;
+
+	node->previous = NULL;
+	node->next = NULL;
+
+	return node;
+}
+
+void list_release_node(list_t* list, node_t* node)
+{
+	if (node) {
+		_list_node_free(list, node);
+	}
+}
+
+
+
 int list_pop_back(list_t* list, void* data)
 {
 	if (list->end) {
@@ -194,7 +454,10 @@ int list_pop_back(list_t* list, void* data)
 			list->end->next = NULL;
 		}
 
-		free(last);
+		if (list->finger == last) {
+			list->finger = NULL;
+		}
+		_list_node_free(list, last);
 		list->size--;
 
 		return 0;
@@ -345,25 +608,19 @@ static node_t* list_merge_lists(node_t* list1, node_t* list2, int (*comp)(const
 #define MERGE_SORT_BOTTOM_UP_NUMLISTS 32
 
 /**
- *
+ * @brief sort a NULL terminated chain of nodes following their next links only. Previous links are left as is.
+ * @return the first node of the sorted chain
  * @see https://en.wikipedia.org/wiki/Merge_sort#Bottom-up_implementation_using_lists
  */
-static int list_merge_sort_bottom_up(list_t* list, int (*comp)(const void*, const void*))
+static node_t* _list_sort_chain(node_t* node, int (*comp)(const void*, const void*))
 {
 	node_t* lists[MERGE_SORT_BOTTOM_UP_NUMLISTS];
-	node_t* node;
 	node_t* next;
 	int i;
 
-	/* list is empty? there's nothing to do */
-	if (list->begin == NULL) {
-		return 0;
-	}
-
 	/* Set all pointers to node as NULL */
 	memset(lists, 0, sizeof(lists));
 
-	node = list->begin;
 	while (node != NULL) {
 		next = node->next;
 		node->next = NULL;
@@ -384,16 +641,36 @@ static int list_merge_sort_bottom_up(list_t* list, int (*comp)(const void*, cons
 		node = list_merge_lists(lists[i], node, comp);
 	}
 
-	/* node now contains the final head of the sorted list so it's saved as such */
-	list->begin = node;
+	return node;
+}
 
-	/* restore previous links and list's last element */
-	list->begin->previous = NULL;
+/**
+ * @brief make head the list's first node, then restore previous links and the list's last element
+ */
+static inline void _list_relink(list_t* list, node_t* head)
+{
+	node_t* node = head;
+
+	list->begin = head;
+	head->previous = NULL;
 	while (node->next != NULL) {
 		node->next->previous = node;
 		node = node->next;
 	}
 	list->end = node;
+}
+
+static int list_merge_sort_bottom_up(list_t* list, int (*comp)(const void*, const void*))
+{
+	/* list is empty? there's nothing to do */
+	if (list->begin == NULL) {
+		return 0;
+	}
+
+	comp = STDCONTAINERS_STATS_COMPARATOR(list, comp);
+
+	/* the sorted chain's head becomes the list's first node */
+	_list_relink(list, _list_sort_chain(list->begin, comp));
 
 	return 0;
 }
@@ -417,13 +694,117 @@ int list_sort_with(list_t* list, int(*comp)(const void*, const void*))
 	return list_merge_sort_bottom_up(list, comp);
 }
 
+int list_splice(list_t* list, node_t* position, list_t* other)
+{
+	if (list == other || list->size_type != other->size_type) return -1;
+	if (other->begin == NULL) return 0;
+
+	_list_link_range_before(list, position, other->begin, other->end);
+	list->size += other->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	other->begin = NULL;
+	other->end = NULL;
+	other->size = 0;
+	other->finger = NULL;
+
+	return 0;
+}
+
+int list_splice_range(list_t* list, node_t* position, list_t* other, node_t* first, node_t* last)
+{
+	node_t* node;
+	int count = 1;
+
+	if (list->size_type != other->size_type || !first || !last) return -1;
+
+	if (list != other) {
+		/* the only way to keep both sizes right is to count what is being moved */
+		for (node = first; node != last; node = node->next) {
+			count++;
+		}
+	}
+
+	_list_unlink_range(other, first, last);
+	_list_link_range_before(list, position, first, last);
+
+	if (list != other) {
+		other->size -= count;
+		list->size += count;
+		STDCONTAINERS_STATS_MAX_SIZE(list);
+	}
+
+	return 0;
+}
+
+int list_split_at_node(list_t* list, node_t* node, list_t* tail)
+{
+	node_t* last = list->end;
+	node_t* curr;
+	int count = 0;
+
+	if (list == tail || list->size_type != tail->size_type || !node) return -1;
+
+	for (curr = node; curr != NULL; curr = curr->next) {
+		count++;
+	}
+
+	_list_unlink_range(list, node, last);
+	_list_link_range_before(tail, NULL, node, last);
+
+	list->size -= count;
+	tail->size += count;
+	STDCONTAINERS_STATS_MAX_SIZE(tail);
+
+	return 0;
+}
+
+int list_merge_sorted_with(list_t* list, list_t* other, int (*comp)(const void*, const void*))
+{
+	node_t* node;
+
+	if (list == other || list->size_type != other->size_type || !comp) return -1;
+	if (other->begin == NULL) return 0;
+
+	comp = STDCONTAINERS_STATS_COMPARATOR(list, comp);
+
+	/* list comes first so that equal elements keep list's ones in front */
+	node = list_merge_lists(list->begin, other->begin, comp);
+
+	/* restore previous links and list's last element */
+	list->begin = node;
+	node->previous = NULL;
+	while (node->next != NULL) {
+		node->next->previous = node;
+		node = node->next;
+	}
+	list->end = node;
+	list->size += other->size;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	other->begin = NULL;
+	other->end = NULL;
+	other->size = 0;
+	other->finger = NULL;
+
+	return 0;
+}
+
+int list_merge_sorted(list_t* list, list_t* other)
+{
+	return list_merge_sorted_with(list, other, list->comparator);
+}
+
 bool list_contains(list_t* list, const void* data)
 {
 	if (list->comparator) {
+		int (*comp)(const void*, const void*) = STDCONTAINERS_STATS_COMPARATOR(list, list->comparator);
 		node_t* node = list->begin;
 
 		while (node) {
-			if (list->comparator(&(node->data[0]), data) == 0) {
+			/* next node is on its way while the comparator runs */
+			STDCONTAINERS_PREFETCH(node->next);
+			if (comp(&(node->data[0]), data) == 0) {
 				return true;
 			}
 			node = node->next;
@@ -441,35 +822,149 @@ int list_add_after(list_t* list, node_t* node, void* data)
 {
 	if (!data) return -1;
 
-	node_t* new_node = (node_t*)malloc(sizeof(node_t) + sizeof(uint8_t) * list->size_type);
-	if (!new_node) return -1; /* memory alloc error */
+	return list_insert_after_node(list, node, data) ? 0 : -1;
+}
+
+node_t* list_insert_before_node(list_t* list, node_t* node, const void* data)
+{
+	node_t* new_node = _list_node_alloc(list);
+	if (!new_node) return NULL; /* memory alloc error */
 
 	memcpy(new_node->data, data, list->size_type);
 
-	new_node->previous = node;
+	_list_link_range_before(list, node, new_node, new_node);
+	list->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	return new_node;
+}
+
+node_t* list_insert_after_node(list_t* list, node_t* node, const void* data)
+{
+	return list_insert_before_node(list, node ? node->next : list->begin, data);
+}
+
+int list_insert(list_t* list, int n, const void* data)
+{
+	if (n < 0 || n > list->size) return -1;
+
+	/* inserting at index size is appending: this is what a NULL position stands for */
+	node_t* position = n == list->size ? NULL : _list_node_at(list, n);
+
+	return list_insert_before_node(list, position, data) ? 0 : -1;
+}
+
+int list_erase_node(list_t* list, node_t* node)
+{
+	if (!node) return -1;
+
+	_list_unlink_range(list, node, node);
+	_list_node_free(list, node);
+	list->size--;
+
+	return 0;
+}
+
+int list_remove_if(list_t* list, int (*pred)(const void* data, void* ctx), void* ctx, list_t* removed)
+{
+	node_t* node = list->begin;
+	node_t* next;
+	node_t* kept = NULL;
+	node_t* first = NULL;
+	node_t* last = NULL;
+	int count = 0;
+
+	if (removed && (removed == list || removed->size_type != list->size_type)) return -1;
 
-	if (node == NULL) {
-		/* insert at beginning of list*/
-		new_node->next = list->begin;
-		list->begin->previous = new_node;
-		list->begin = new_node;
+	while (node) {
+		next = node->next;
+		STDCONTAINERS_PREFETCH(next);
+
+		if (pred(node->data, ctx)) {
+			if (removed) {
+				/* chain the removed nodes together, to be handed over at the end */
+				node->previous = last;
+				if (last) {
+					last->next = node;
+				}
+				else {
+					first = node;
+				}
+				last = node;
+			}
+			else {
+				/* released right away, while the node is still in cache */
+				_list_node_free(list, node);
+			}
+			count++;
+		}
+		else {
+			/* kept nodes are only written to when a removed node was in front of them */
+			if (node->previous != kept) {
+				node->previous = kept;
+				if (kept) {
+					kept->next = node;
+				}
+				else {
+					list->begin = node;
+				}
+			}
+			kept = node;
+		}
+
+		node = next;
 	}
-	else if (node->next == NULL) {
-		/* insert at end of list*/
-		new_node->next = NULL;
-		node->next = new_node;
-		list->end = new_node;
+
+	if (count == 0) return 0;
+
+	if (kept) {
+		kept->next = NULL;
 	}
 	else {
-		new_node->next = node->next;
-		node->next->previous = new_node;
-		node->next = new_node;
+		list->begin = NULL;
+	}
+	list->end = kept;
+	list->size -= count;
+	list->finger = NULL;
+
+	if (removed) {
+		_list_link_range_before(removed, NULL, first, last);
+		removed->size += count;
+		STDCONTAINERS_STATS_MAX_SIZE(removed);
 	}
 
-	list->size++;
+	return count;
+}
+
+int list_erase(list_t* list, int n)
+{
+	if (n < 0 || n >= list->size) return -1;
+
+	return list_erase_node(list, _list_node_at(list, n));
+}
+
+int list_move_to_front(list_t* list, node_t* node)
+{
+	if (!node) return -1;
+
+	if (node != list->begin) {
+		_list_unlink_range(list, node, node);
+		_list_link_range_before(list, list->begin, node, node);
+	}
 
 	return 0;
+}
+
+int list_move_to_back(list_t* list, node_t* node)
+{
+	if (!node) return -1;
 
+	if (node != list->end) {
+		_list_unlink_range(list, node, node);
+		_list_link_range_before(list, NULL, node, node);
+	}
+
+	return 0;
 }
 
 #if defined(_MSC_VER)
@@ -478,45 +973,62 @@ int list_add_after(list_t* list, node_t* node, void* data)
 #endif
 static node_t* list_add_ordered_with(list_t* list, const void* data, int (*comp)(const void*, const void*))
 {
+	node_t* new_node;
+	node_t* current;
 
 	if (!data) return NULL;
 
-	if (list->size == 0) return list_push_back(list, data);
+	if (list->size == 0) {
+		new_node = list_push_back(list, data);
+		if (list->finger_enabled) {
+			list->finger = new_node;
+		}
+		return new_node;
+	}
 
 	/* set node data */
-	node_t* new_node = (node_t*)malloc(sizeof(node_t) + sizeof(uint8_t) * list->size_type);
+	new_node = _list_node_alloc(list);
 	if (!new_node) return NULL; /* memory alloc error */
 	memcpy(new_node->data, data, list->size_type);
 
-	/* init position to the list beginning and copy data to the new node*/
-	node_t* current = list->begin;
-	node_t* previous = NULL;
+	comp = STDCONTAINERS_STATS_COMPARATOR(list, comp);
 
-	/* find spot in list to add the new element */
-	while (current != NULL && comp((&(current->data[0])), data) < 0) {
-		previous = current;
-		current = current->next;
+	/* find the first node not less than data: the new element goes right before it */
+	if (list->finger_enabled && list->finger) {
+		current = list->finger;
+		if (comp(&(current->data[0]), data) >= 0) {
+			/* the spot is at the finger or before it */
+			while (current->previous && comp(&(current->previous->data[0]), data) >= 0) {
+				STDCONTAINERS_PREFETCH(current->previous->previous);
+				current = current->previous;
+			}
+		}
+		else {
+			current = current->next;
+			while (current != NULL && comp(&(current->data[0]), data) < 0) {
+				STDCONTAINERS_PREFETCH(current->next);
+				current = current->next;
+			}
+		}
+	}
+	else {
+		current = list->begin;
+		while (current != NULL) {
+			STDCONTAINERS_PREFETCH(current->next);
+			if (comp((&(current->data[0])), data) >= 0) break;
+			current = current->next;
+		}
 	}
 
-	new_node->previous = previous;
-	new_node->next = current;
+	/* a NULL current appends the element at the end */
+	_list_link_range_before(list, current, new_node, new_node);
 
-	if (current == NULL) {
-		/* iterated through the entire list: item will be added at the end */
-		previous->next = new_node;
-		list->end = new_node;
-	}
-	if (previous == NULL) {
-		/* hasn't even passed the first test: item will be added at the beginning */
-		current->previous = new_node;
-		list->begin = new_node;
-	}
-	else {
-		previous->next->previous = new_node;
-		previous->next = new_node;
+	if (list->finger_enabled) {
+		list->finger = new_node;
 	}
 
 	list->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
 
 	return new_node;
 }
@@ -534,4 +1046,72 @@ node_t* list_add_ordered(list_t* list, const void* data) {
 		return NULL;
 	}
 
-}
\ No newline at end of file
+}
+
+int list_add_ordered_n(list_t* list, const void* data, int count)
+{
+	const uint8_t* p = (const uint8_t*)data;
+	int (*comp)(const void*, const void*);
+	node_t* batch = NULL;
+	node_t** link = &batch;
+	node_t* node;
+	int i;
+
+	if (!list->comparator || !data || count < 0) return -1;
+	if (count == 0) return 0;
+
+	/* every node is allocated before the list is touched: on failure the list is left as it was */
+	for (i = 0; i < count; i++) {
+		node = _list_node_alloc(list);
+		if (!node) {
+			*link = NULL;
+			_list_node_free_chain(list, batch);
+			return -1;
+		}
+		memcpy(node->data, p, list->size_type);
+		p += list->size_type;
+
+		*link = node;
+		link = &node->next;
+	}
+	*link = NULL;
+
+	comp = STDCONTAINERS_STATS_COMPARATOR(list, list->comparator);
+
+	/* the batch comes first so that, like list_add_ordered, new elements go before equal ones */
+	_list_relink(list, list_merge_lists(_list_sort_chain(batch, comp), list->begin, comp));
+
+	list->size += count;
+	STDCONTAINERS_STATS_MAX_SIZE(list);
+
+	return 0;
+}
+
+int list_set_finger(list_t* list, bool enabled)
+{
+	list->finger_enabled = enabled;
+	list->finger = NULL;
+	return 0;
+}
+
+int list_get_stats(const list_t* list, container_stats_t* stats)
+{
+#ifdef STDCONTAINERS_STATS
+	memcpy(stats, &list->stats, sizeof(container_stats_t));
+	return 0;
+#else
+	(void)list;
+	memset(stats, 0x00, sizeof(container_stats_t));
+	return -1;
+#endif
+}
+
+void list_reset_stats(list_t* list)
+{
+#ifdef STDCONTAINERS_STATS
+	memset(&list->stats, 0x00, sizeof(container_stats_t));
+	list->stats.max_size = (uint64_t)list->size;
+#else
+	(void)list;
+#endif
+}
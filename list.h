@@ -32,6 +32,8 @@ SOFTWARE.
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include "stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +65,11 @@ typedef struct list_t {
     node_t* begin;
     node_t* end;
     int (*comparator)(const void*, const void*);
+    node_t* finger; /* finger mode: node added by the last list_add_ordered, where the next one starts searching */
+    bool finger_enabled;
+#ifdef STDCONTAINERS_STATS
+    container_stats_t stats;
+#endif
 }list_t;
 
 
@@ -92,6 +99,21 @@ void list_clear(list_t* list);
   */
 void list_destroy(list_t* list);
 
+/**
+  * @brief reallocate every node of the list and link them by increasing address.
+  * After a long period of insertions and deletions, the nodes of a list end up scattered all
+  * over the heap and iterating becomes dominated by cache misses. Once compacted, iterating
+  * the list walks memory forward.
+  * @note nodes are still allocated one by one: they are back to back only where malloc hands out
+  * contiguous memory, which it rarely does while it holds holes of the node size left by earlier frees
+  * @param  list: the list to compact
+  * @return 0: success
+  *         -1: failure. The list is left untouched
+  * @warning every node_t* and data pointer previously obtained from the list is invalidated.
+  * If the list is shared with other threads, they must be locked out for the duration of the call.
+  */
+int list_compact(list_t* list);
+
 
 
 /*********************/
@@ -121,7 +143,57 @@ void* list_front(list_t* list);
  */
 #define list_peek(list) list_front(list)
 
-int list_assign(list_t* vector, int n, const void* data);
+/**
+  * @brief assign the given value to the n th element of the list
+  * @param  list: the list to perform the operation on
+  * @param  n: the 0-indexed element to assign
+  * @param  data: reference to the list's data type
+  * @return 0: success
+  *         -1: failure
+  * @note the node is found by walking the list from its closest end
+  */
+int list_assign(list_t* list, int n, const void* data);
+
+/*********************/
+/* iteration         */
+/*********************/
+
+#define LIST_CURSOR_BATCH_SIZE 64
+
+typedef struct list_cursor_t {
+    node_t* node;
+}list_cursor_t;
+
+/**
+  * @brief position a cursor on the first element of the given list
+  * @param  cursor: the cursor to initialize
+  * @param  list: the list to iterate over
+  */
+void list_cursor_init(list_cursor_t* cursor, list_t* list);
+
+/**
+  * @brief fetch the next batch of elements of the list
+  * The batch is filled with pointers to the elements' data, in list order. Before returning,
+  * the first node of the following batch is prefetched so that its cache miss overlaps with
+  * the processing of the current batch.
+  * @param  cursor: the cursor to advance
+  * @param  batch: array receiving up to max pointers to data
+  * @param  max: capacity of batch, typically LIST_CURSOR_BATCH_SIZE
+  * @return number of pointers written to batch. 0 once the end of the list is reached
+  * @code{c}
+  * void* batch[LIST_CURSOR_BATCH_SIZE];
+  * list_cursor_t cursor;
+  * int count;
+  * list_cursor_init(&cursor, &list);
+  * while ((count = list_cursor_next(&cursor, batch, LIST_CURSOR_BATCH_SIZE)) > 0) {
+  *     for (int i = 0; i < count; i++) {
+  *         sum += *(int*)batch[i];
+  *     }
+  * }
+  * @endcode
+  * @warning the list must not be modified while a cursor is iterating over it
+  */
+int list_cursor_next(list_cursor_t* cursor, void** batch, int max);
 
 /*********************/
 /* insertion         */
@@ -168,11 +240,91 @@ void* list_back(list_t* list);
   * @return node_t*: the node newly added
   *         NULL: failure
   * @warning    list_set_comparator must be called prior to calling list_contains
+  * @note the search starts from list->begin, or from the last added node in finger mode
   * @see list_set_comparator
+  * @see list_set_finger
   */
 node_t* list_add_ordered(list_t* list, const void* data);
 
-int list_insert(list_t* vector, int n, const void* data);
+/**
+  * @brief add count elements to a sorted list while respecting its order. The batch is sorted on its
+  * own then merged into the list in a single pass, instead of searching the list once per element.
+  * @param  list: the list to add the items to
+  * @param  data: the first of count contiguous elements of the list's data type
+  * @param  count: number of elements to add
+  * @return 0: success
+  *         -1: failure. No element is added
+  * @warning list_set_comparator must be called prior to calling list_add_ordered_n
+  * @note O(n + k logk) comparisons for k elements added to a list of n elements, against O(n k)
+  * for k calls to list_add_ordered. Every new element still gets its own node.
+  * @see list_add_ordered
+  */
+int list_add_ordered_n(list_t* list, const void* data, int count);
+
+/**
+  * @brief turn finger mode on or off. In finger mode, list_add_ordered remembers the node it added
+  * and starts its next search from there, walking forward or backward as needed: a stream of
+  * nearly increasing values is inserted in O(1) amortized instead of O(n) per element.
+  * @param  list: the list to perform the operation on
+  * @param  enabled: true to turn finger mode on, false to turn it off
+  * @return 0: success
+  * @note the finger is dropped whenever its node leaves the list, and by operations moving or
+  * reallocating nodes in bulk (clear, compact, remove_if, split, splice of a range)
+  */
+int list_set_finger(list_t* list, bool enabled);
+
+/**
+  * @brief insert data so that it becomes the n th element of the list
+  * @param  list: the list to add the item to
+  * @param  n: the 0-indexed position of the new element. list->size appends it
+  * @param  data: reference to the list's data type holding the value to be added
+  * @return 0: success
+  *         -1: failure
+  * @note the position is found by walking the list from its closest end. When a node
+  * is at hand, list_insert_before_node and list_insert_after_node are O(1)
+  */
+int list_insert(list_t* list, int n, const void* data);
+
+/**
+  * @brief add data right before the given node
+  * @param  list: the list to add the item to
+  * @param  node: node of list. NULL adds data at the end of the list
+  * @param  data: reference to the list's data type holding the value to be added
+  * @return node_t*: the node newly added
+  *         NULL: failure
+  * @note complexity is O(1)
+  */
+node_t* list_insert_before_node(list_t* list, node_t* node, const void* data);
+
+/**
+  * @brief add data right after the given node
+  * @param  list: the list to add the item to
+  * @param  node: node of list. NULL adds data at the beginning of the list
+  * @param  data: reference to the list's data type holding the value to be added
+  * @return node_t*: the node newly added
+  *         NULL: failure
+  * @note complexity is O(1)
+  */
+node_t* list_insert_after_node(list_t* list, node_t* node, const void* data);
+
+/**
+  * @brief add an uninitialized element at the end of the list
+  * @param  list: the list to add the item to
+  * @return void*: pointer to the new element's data, to be filled in place by the caller
+  *         NULL: failure
+  * @note saves building the element in a temporary that list_push_back would copy. The node
+  * holding the data is list->end
+  */
+void* list_emplace_back(list_t* list);
+
+/**
+  * @brief add an uninitialized element at the beginning of the list
+  * @param  list: the list to add the item to
+  * @return void*: pointer to the new element's data, to be filled in place by the caller
+  *         NULL: failure
+  * @see list_emplace_back
+  */
+void* list_emplace_front(list_t* list);
 
 /*********************/
 /* deletion          */
@@ -204,8 +356,157 @@ int list_pop_back(list_t* list, void* data);
  */
 #define list_pop(list, data) list_pop_back(list, data)
 
+/**
+  * @brief detach the first node of the list without copying nor freeing it
+  * @param  list: the list to remove the item from
+  * @return node_t*: the detached node, whose data can be read in place
+  *         NULL: the list is empty
+  * @warning the node must be given back with list_release_node once done with it
+  */
+node_t* list_pop_front_node(list_t* list);
 
-int list_erase(list_t*, int n);
+/**
+  * @brief detach the last node of the list without copying nor freeing it
+  * @param  list: the list to remove the item from
+  * @return node_t*: the detached node, whose data can be read in place
+  *         NULL: the list is empty
+  * @warning the node must be given back with list_release_node once done with it
+  */
+node_t* list_pop_back_node(list_t* list);
+
+/**
+  * @brief free a node previously detached with list_pop_front_node or list_pop_back_node
+  * @param  list: the list the node was detached from
+  * @param  node: the node to free. NULL is accepted
+  */
+void list_release_node(list_t* list, node_t* node);
+
+
+/**
+  * @brief remove the n th element of the list
+  * @param  list: the list to remove the item from
+  * @param  n: the 0-indexed element to remove
+  * @return 0: success
+  *         -1: failure
+  * @note the node is found by walking the list from its closest end. When a node
+  * is at hand, list_erase_node is O(1)
+  */
+int list_erase(list_t* list, int n);
+
+/**
+  * @brief remove the given node from the list
+  * @param  list: the list to remove the item from
+  * @param  node: node of list to be removed. It is freed and must not be used afterwards
+  * @return 0: success
+  *         -1: failure
+  * @note complexity is O(1)
+  */
+int list_erase_node(list_t* list, node_t* node);
+
+/**
+  * @brief remove all elements for which pred returns non zero, in a single traversal
+  * @param  list: the list to remove the items from
+  * @param  pred: predicate called once per element, in order, with the user context
+  * @param  ctx: user context passed to pred. Can be NULL
+  * @param  removed: optional list receiving the removed nodes, appended in order. When NULL the
+  *         removed nodes are freed during the traversal, while they are still in cache
+  * @return the number of elements removed
+  *         -1: failure, removed is list itself or does not hold the same size_type
+  * @note the kept elements keep their order and their nodes
+  */
+int list_remove_if(list_t* list, int (*pred)(const void* data, void* ctx), void* ctx, list_t* removed);
+
+
+/*********************/
+/* reordering        */
+/*********************/
+
+/**
+  * @brief move a node of the list to its beginning, e.g. to mark it as most recently used
+  * @param  list: the list to perform the operation on
+  * @param  node: node of list to be moved
+  * @return 0: success
+  *         -1: failure
+  * @note complexity is O(1). No memory is allocated or copied
+  */
+int list_move_to_front(list_t* list, node_t* node);
+
+/**
+  * @brief move a node of the list to its end
+  * @param  list: the list to perform the operation on
+  * @param  node: node of list to be moved
+  * @return 0: success
+  *         -1: failure
+  * @note complexity is O(1). No memory is allocated or copied
+  */
+int list_move_to_back(list_t* list, node_t* node);
+
+
+
+/*********************/
+/* splicing          */
+/*********************/
+
+/**
+  * @brief move all elements of other into list, before position. No node is allocated or copied.
+  * @param  list: the list receiving the elements
+  * @param  position: node of list before which the elements are inserted. NULL appends them at the end
+  * @param  other: the list giving away its elements. It is left empty
+  * @return 0: success
+  *         -1: failure, e.g. the lists do not hold the same size_type
+  * @note complexity is O(1)
+  */
+int list_splice(list_t* list, node_t* position, list_t* other);
+
+/**
+  * @brief move the nodes first to last (included) of other into list, before position.
+  * No node is allocated or copied. list and other can be the same list, in which case
+  * position must not be part of the range being moved.
+  * @param  list: the list receiving the elements
+  * @param  position: node of list before which the elements are inserted. NULL appends them at the end
+  * @param  other: the list giving away the elements
+  * @param  first: first node to be moved
+  * @param  last: last node to be moved. It must be first or come after first in other
+  * @return 0: success
+  *         -1: failure
+  * @note complexity is O(number of moved nodes) as they need to be counted to keep sizes right.
+  * Moving nodes within the same list is O(1).
+  */
+int list_splice_range(list_t* list, node_t* position, list_t* other, node_t* first, node_t* last);
+
+/**
+  * @brief split the list in two: node and all the nodes after it are moved to the end of tail
+  * @param  list: the list to split
+  * @param  node: first node of list to be moved
+  * @param  tail: the list receiving the nodes, typically an empty list
+  * @return 0: success
+  *         -1: failure
+  * @note complexity is O(number of moved nodes)
+  */
+int list_split_at_node(list_t* list, node_t* node, list_t* tail);
+
+/**
+  * @brief merge two sorted lists. All elements of other are moved into list, which stays sorted.
+  * The merge is stable: equal elements keep list's ones first.
+  * @param  list: a sorted list receiving the elements
+  * @param  other: a sorted list giving away its elements. It is left empty
+  * @return 0: success
+  *         -1: failure
+  * @warning list_set_comparator must be called on list prior to calling list_merge_sorted
+  * @note complexity is O(n + m) comparisons and no allocation
+  */
+int list_merge_sorted(list_t* list, list_t* other);
+
+/**
+  * @brief merge two sorted lists according to the comparator passed as argument
+  * @param  list: a sorted list receiving the elements
+  * @param  other: a sorted list giving away its elements. It is left empty
+  * @param  comp: a standard comparator function
+  * @return 0: success
+  *         -1: failure
+  * @see list_merge_sorted
+  */
+int list_merge_sorted_with(list_t* list, list_t* other, int (*comp)(const void*, const void*));
 
 
 
@@ -260,6 +561,22 @@ int list_sort_with(list_t* list, int(*comp)(const void*, const void*));
   */
 bool list_contains(list_t* list, const void* data);
 
+/**
+  * @brief copy the counters recorded by the list since its creation or the last list_reset_stats
+  * @param      list: list to perform the operation on
+  * @param      stats: where the counters are copied
+  * @return     0: success
+  *             -1: the library was compiled without STDCONTAINERS_STATS. stats is zero filled
+  * @see stats.h
+  */
+int list_get_stats(const list_t* list, container_stats_t* stats);
+
+/**
+  * @brief reset the list's counters. max_size restarts from the current size
+  * @param      list: list to perform the operation on
+  */
+void list_reset_stats(list_t* list);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,269 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file lockfree_stack.c
+@author Tony Pottier
+@brief Source code for the lock-free Treiber stack
+
+Each pool node starts with the 32 bits index of the next node, followed by
+the element itself at offset 8. Both the stack and its free list are Treiber
+stacks over these nodes: a push links the node to the current head and
+installs it with a compare-and-swap, a pop replaces the head with its next
+node the same way. The next field is only accessed atomically since a thread
+may read it from a node which is being popped and reused concurrently; the
+head's tag then makes that thread's compare-and-swap fail.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "lockfree_stack.h"
+#include "spinlock.h"
+
+#define _LOCKFREE_STACK_DATA_OFFSET 8
+
+#define _LOCKFREE_STACK_PACK(tag, index) (((uint64_t)(tag) << 32) | (uint64_t)(index))
+#define _LOCKFREE_STACK_INDEX(word) ((uint32_t)(word))
+#define _LOCKFREE_STACK_TAG(word) ((uint32_t)((word) >> 32))
+
+/* per thread state of the elimination slot picker */
+static __thread uint32_t _lockfree_stack_seed;
+
+
+static inline uint32_t* _lockfree_stack_next(lockfree_stack_t* stack, uint32_t index)
+{
+	return (uint32_t*)(stack->nodes + (size_t)index * stack->node_size);
+}
+
+static inline uint8_t* _lockfree_stack_data(lockfree_stack_t* stack, uint32_t index)
+{
+	return stack->nodes + (size_t)index * stack->node_size + _LOCKFREE_STACK_DATA_OFFSET;
+}
+
+/**
+ * @brief single attempt at pushing node index on top
+ * @return true: success, false: lost the race against another thread
+ */
+static inline bool _lockfree_stack_try_push(lockfree_stack_t* stack, uint64_t* top, uint32_t index)
+{
+	uint64_t old = __atomic_load_n(top, __ATOMIC_RELAXED);
+
+	__atomic_store_n(_lockfree_stack_next(stack, index), _LOCKFREE_STACK_INDEX(old), __ATOMIC_RELAXED);
+
+	return __atomic_compare_exchange_n(top, &old, _LOCKFREE_STACK_PACK(_LOCKFREE_STACK_TAG(old) + 1, index), false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief single attempt at popping the node on top
+ * @return the popped node, or LOCKFREE_STACK_NIL with empty set when top is empty
+ * and left untouched when the race was lost against another thread
+ */
+static inline uint32_t _lockfree_stack_try_pop(lockfree_stack_t* stack, uint64_t* top, bool* empty)
+{
+	uint64_t old = __atomic_load_n(top, __ATOMIC_ACQUIRE);
+	uint32_t index = _LOCKFREE_STACK_INDEX(old);
+	uint32_t next;
+
+	if (index == LOCKFREE_STACK_NIL) {
+		*empty = true;
+		return LOCKFREE_STACK_NIL;
+	}
+
+	/* index may be popped and reused under our feet: the tag check in the CAS catches it */
+	next = __atomic_load_n(_lockfree_stack_next(stack, index), __ATOMIC_RELAXED);
+
+	if (__atomic_compare_exchange_n(top, &old, _LOCKFREE_STACK_PACK(_LOCKFREE_STACK_TAG(old) + 1, next), false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		return index;
+	}
+
+	return LOCKFREE_STACK_NIL;
+}
+
+static inline uint64_t* _lockfree_stack_random_slot(lockfree_stack_t* stack)
+{
+	uint32_t x = _lockfree_stack_seed;
+
+	if (x == 0) {
+		x = (uint32_t)(uintptr_t)&_lockfree_stack_seed | 1;
+	}
+	/* xorshift32 */
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	_lockfree_stack_seed = x;
+
+	return &stack->elimination[x % stack->elimination_slots];
+}
+
+/**
+ * @brief offer node index to a concurrent pop through the elimination array
+ * @return true: a pop took the node, the push is complete
+ */
+static bool _lockfree_stack_eliminate_push(lockfree_stack_t* stack, uint32_t index)
+{
+	uint64_t* slot;
+	uint64_t old, offer;
+	int i;
+
+	if (!stack->elimination) return false;
+
+	slot = _lockfree_stack_random_slot(stack);
+	old = __atomic_load_n(slot, __ATOMIC_RELAXED);
+	if (_LOCKFREE_STACK_INDEX(old) != LOCKFREE_STACK_NIL) return false;
+
+	offer = _LOCKFREE_STACK_PACK(_LOCKFREE_STACK_TAG(old) + 1, index);
+	if (!__atomic_compare_exchange_n(slot, &old, offer, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) return false;
+
+	for (i = 0; i < LOCKFREE_STACK_ELIMINATION_SPINS; i++) {
+		if (__atomic_load_n(slot, __ATOMIC_RELAXED) != offer) return true;
+		SPINLOCK_PAUSE();
+	}
+
+	/* nobody came: take the offer back, unless a pop grabs it at the very last moment */
+	old = offer;
+	return !__atomic_compare_exchange_n(slot, &old, _LOCKFREE_STACK_PACK(_LOCKFREE_STACK_TAG(offer) + 1, LOCKFREE_STACK_NIL), false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief take a node offered by a concurrent push in the elimination array
+ * @return the node, or LOCKFREE_STACK_NIL if none was found
+ */
+static uint32_t _lockfree_stack_eliminate_pop(lockfree_stack_t* stack)
+{
+	uint64_t* slot;
+	uint64_t old;
+
+	if (!stack->elimination) return LOCKFREE_STACK_NIL;
+
+	slot = _lockfree_stack_random_slot(stack);
+	old = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+	if (_LOCKFREE_STACK_INDEX(old) == LOCKFREE_STACK_NIL) return LOCKFREE_STACK_NIL;
+
+	if (__atomic_compare_exchange_n(slot, &old, _LOCKFREE_STACK_PACK(_LOCKFREE_STACK_TAG(old) + 1, LOCKFREE_STACK_NIL), false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		return _LOCKFREE_STACK_INDEX(old);
+	}
+
+	return LOCKFREE_STACK_NIL;
+}
+
+
+int lockfree_stack_create(lockfree_stack_t* stack, size_t size_type, size_t capacity)
+{
+	return lockfree_stack_create_with(stack, size_type, capacity, 0);
+}
+
+int lockfree_stack_create_with(lockfree_stack_t* stack, size_t size_type, size_t capacity, size_t elimination_slots)
+{
+	uint32_t i;
+
+	if (!stack || capacity == 0 || capacity >= LOCKFREE_STACK_NIL || elimination_slots >= LOCKFREE_STACK_NIL) return -1;
+
+	memset(stack, 0x00, sizeof(lockfree_stack_t));
+	stack->size_type = size_type;
+	stack->capacity = (uint32_t)capacity;
+	stack->node_size = (_LOCKFREE_STACK_DATA_OFFSET + size_type + 7) & ~(size_t)7;
+
+	if (capacity > SIZE_MAX / stack->node_size) return -1;
+
+	stack->nodes = (uint8_t*)malloc(capacity * stack->node_size);
+	if (!stack->nodes) return -1;
+
+	if (elimination_slots) {
+		stack->elimination = (uint64_t*)malloc(elimination_slots * sizeof(uint64_t));
+		if (!stack->elimination) {
+			lockfree_stack_destroy(stack);
+			return -1;
+		}
+		stack->elimination_slots = (uint32_t)elimination_slots;
+		for (i = 0; i < stack->elimination_slots; i++) {
+			stack->elimination[i] = _LOCKFREE_STACK_PACK(0, LOCKFREE_STACK_NIL);
+		}
+	}
+
+	/* every node starts on the free list, in pool order */
+	for (i = 0; i < stack->capacity; i++) {
+		*_lockfree_stack_next(stack, i) = i + 1 < stack->capacity ? i + 1 : LOCKFREE_STACK_NIL;
+	}
+	stack->free = _LOCKFREE_STACK_PACK(0, 0);
+	stack->head = _LOCKFREE_STACK_PACK(0, LOCKFREE_STACK_NIL);
+
+	return 0;
+}
+
+void lockfree_stack_destroy(lockfree_stack_t* stack)
+{
+	free(stack->nodes);
+	free(stack->elimination);
+	memset(stack, 0x00, sizeof(lockfree_stack_t));
+}
+
+int lockfree_stack_push(lockfree_stack_t* stack, const void* data)
+{
+	bool full = false;
+	uint32_t index;
+
+	do {
+		index = _lockfree_stack_try_pop(stack, &stack->free, &full);
+		if (full) return -1;
+	} while (index == LOCKFREE_STACK_NIL);
+
+	/* the node is ours until it is published on the stack */
+	memcpy(_lockfree_stack_data(stack, index), data, stack->size_type);
+
+	while (!_lockfree_stack_try_push(stack, &stack->head, index)) {
+		if (_lockfree_stack_eliminate_push(stack, index)) break;
+	}
+
+	return 0;
+}
+
+int lockfree_stack_pop(lockfree_stack_t* stack, void* data)
+{
+	bool empty = false;
+	uint32_t index;
+
+	for (;;) {
+		index = _lockfree_stack_try_pop(stack, &stack->head, &empty);
+		if (index != LOCKFREE_STACK_NIL) break;
+		if (empty) return -1;
+
+		index = _lockfree_stack_eliminate_pop(stack);
+		if (index != LOCKFREE_STACK_NIL) break;
+	}
+
+	if (data) {
+		memcpy(data, _lockfree_stack_data(stack, index), stack->size_type);
+	}
+
+	while (!_lockfree_stack_try_push(stack, &stack->free, index)) {
+		/* retry: the free list is only contended by other push/pop */
+	}
+
+	return 0;
+}
+
+bool lockfree_stack_empty(lockfree_stack_t* stack)
+{
+	return _LOCKFREE_STACK_INDEX(__atomic_load_n(&stack->head, __ATOMIC_RELAXED)) == LOCKFREE_STACK_NIL;
+}
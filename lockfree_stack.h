@@ -0,0 +1,139 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file lockfree_stack.h
+@author Tony Pottier
+@brief Lock-free concurrent stack (Treiber stack) with inline element storage
+
+lockfree_stack_t can be pushed to and popped from by any number of threads
+without locks. Elements of size_type bytes are stored inline in a pool of
+nodes allocated once at creation: the stack has a fixed capacity, and since
+the pool is never freed while the stack exists, a thread may always safely
+read a node even if another thread just popped it.
+
+Nodes are addressed by a 32 bits index rather than a pointer. The head of the
+stack packs that index with a 32 bits tag incremented on every update, so
+that a compare-and-swap fails if the head was popped and pushed back in the
+meantime (the ABA problem). Free nodes are kept on a second stack built the
+same way.
+
+Under heavy contention, a failed compare-and-swap can optionally fall back to
+an elimination array: a push and a pop meeting in the same slot exchange the
+element directly and both complete without touching the head.
+
+Requires GCC or clang __atomic builtins.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _LOCKFREE_STACK_H_
+#define _LOCKFREE_STACK_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* index of "no node": end of a stack, or empty elimination slot */
+#define LOCKFREE_STACK_NIL 0xFFFFFFFFu
+
+/* how long a push waits in the elimination array for a pop to take its element */
+#define LOCKFREE_STACK_ELIMINATION_SPINS 64
+
+#define LOCKFREE_STACK_CACHE_LINE 64
+
+typedef struct lockfree_stack_t {
+	/* head and free list are the contended words: keep them on their own cache lines */
+	uint64_t head;
+	uint8_t _padding0[LOCKFREE_STACK_CACHE_LINE - sizeof(uint64_t)];
+	uint64_t free;
+	uint8_t _padding1[LOCKFREE_STACK_CACHE_LINE - sizeof(uint64_t)];
+	uint8_t* nodes;
+	size_t node_size;
+	size_t size_type;
+	uint32_t capacity;
+	uint32_t elimination_slots;
+	uint64_t* elimination;
+}lockfree_stack_t;
+
+
+/**
+  * @brief initialize an empty stack able to hold up to capacity elements, without elimination array
+  * @param      stack: pointer to the lockfree_stack_t struct to be initialized
+  * @param		size_type: size in bytes of the elements to be stored
+  * @param		capacity: maximum number of elements in the stack
+  * @return		0: success
+  *				-1: failure
+  */
+int lockfree_stack_create(lockfree_stack_t* stack, size_t size_type, size_t capacity);
+
+/**
+  * @brief initialize an empty stack able to hold up to capacity elements
+  * @param      stack: pointer to the lockfree_stack_t struct to be initialized
+  * @param		size_type: size in bytes of the elements to be stored
+  * @param		capacity: maximum number of elements in the stack
+  * @param		elimination_slots: size of the elimination array, 0 to disable elimination.
+  *				About half the number of threads hammering the stack is a good value
+  * @return		0: success
+  *				-1: failure
+  */
+int lockfree_stack_create_with(lockfree_stack_t* stack, size_t size_type, size_t capacity, size_t elimination_slots);
+
+/**
+  * @brief free all memory held by the stack. No other thread may be using the stack.
+  * @param  stack: the stack to perform the operation on
+  */
+void lockfree_stack_destroy(lockfree_stack_t* stack);
+
+/**
+  * @brief push a copy of data on top of the stack
+  * @param  stack: the stack to perform the operation on
+  * @param  data: reference to the element to push
+  * @return 0: success
+  *         -1: the stack is full
+  */
+int lockfree_stack_push(lockfree_stack_t* stack, const void* data);
+
+/**
+  * @brief pop the element on top of the stack
+  * @param  stack: the stack to perform the operation on
+  * @param  data: receives a copy of the popped element. Can be NULL
+  * @return 0: success
+  *         -1: the stack is empty
+  */
+int lockfree_stack_pop(lockfree_stack_t* stack, void* data);
+
+/**
+  * @brief check whether the stack is empty. The answer may be outdated as soon as it is returned.
+  */
+bool lockfree_stack_empty(lockfree_stack_t* stack);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,294 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file lru_cache.c
+@author Tony Pottier
+@brief Source code for the fixed capacity LRU cache
+
+Each pool node holds a list_t node_t header followed by the entry: the next
+entry of the same hash bucket, the key's hash, the key and the value. The
+first size nodes of the recency list are in use, the others are free: the
+node to fill on a put is therefore always the end of the list, whether the
+cache is full (and it holds the entry to evict) or not.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "lru_cache.h"
+
+/* keys, values and nodes are aligned on 8 bytes */
+#define _LRU_CACHE_ALIGN(n) (((n) + (size_t)7) & ~(size_t)7)
+
+typedef struct lru_cache_entry_t {
+	node_t* chain;
+	uint32_t hash;
+}lru_cache_entry_t;
+
+#define _LRU_CACHE_KEY_OFFSET _LRU_CACHE_ALIGN(sizeof(lru_cache_entry_t))
+
+static inline lru_cache_entry_t* _lru_cache_entry(node_t* node)
+{
+	return (lru_cache_entry_t*)node->data;
+}
+
+static inline void* _lru_cache_key(node_t* node)
+{
+	return node->data + _LRU_CACHE_KEY_OFFSET;
+}
+
+static inline void* _lru_cache_value(lru_cache_t* cache, node_t* node)
+{
+	return node->data + _LRU_CACHE_KEY_OFFSET + _LRU_CACHE_ALIGN(cache->key_size);
+}
+
+static inline node_t** _lru_cache_bucket(lru_cache_t* cache, uint32_t hash)
+{
+	return &cache->buckets[hash & cache->bucket_mask];
+}
+
+/**
+ * @brief find the node holding key
+ * @return the link pointing to the node in its hash bucket, or NULL if key is not in the cache
+ */
+static node_t** _lru_cache_find(lru_cache_t* cache, const void* key, uint32_t hash)
+{
+	node_t** link = _lru_cache_bucket(cache, hash);
+	lru_cache_entry_t* entry;
+
+	while (*link != NULL) {
+		entry = _lru_cache_entry(*link);
+		if (entry->hash == hash && memcmp(_lru_cache_key(*link), key, cache->key_size) == 0) {
+			return link;
+		}
+		link = &entry->chain;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief remove the given node from its hash bucket
+ */
+static void _lru_cache_unchain(lru_cache_t* cache, node_t* node)
+{
+	node_t** link = _lru_cache_bucket(cache, _lru_cache_entry(node)->hash);
+
+	while (*link != node) {
+		link = &_lru_cache_entry(*link)->chain;
+	}
+	*link = _lru_cache_entry(node)->chain;
+}
+
+
+uint32_t lru_cache_hash_fnv1a(const void* key, size_t key_size)
+{
+	const uint8_t* p = (const uint8_t*)key;
+	uint32_t hash = 2166136261u;
+	size_t i;
+
+	for (i = 0; i < key_size; i++) {
+		hash ^= p[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+int lru_cache_create(lru_cache_t* cache, size_t key_size, size_t value_size, size_t capacity)
+{
+	return lru_cache_create_with(cache, key_size, value_size, capacity, lru_cache_hash_fnv1a);
+}
+
+int lru_cache_create_with(lru_cache_t* cache, size_t key_size, size_t value_size, size_t capacity, lru_cache_hash_t hash)
+{
+	size_t node_size, buckets = 1, i;
+	node_t* node;
+	node_t* previous = NULL;
+
+	if (!cache || !hash || key_size == 0 || capacity == 0 || capacity > INT_MAX) return -1;
+
+	memset(cache, 0x00, sizeof(lru_cache_t));
+
+	node_size = _LRU_CACHE_ALIGN(sizeof(node_t) + _LRU_CACHE_KEY_OFFSET + _LRU_CACHE_ALIGN(key_size) + value_size);
+	if (capacity > SIZE_MAX / node_size) return -1;
+
+	/* keep the load factor of the hash index under 1 */
+	while (buckets < capacity) {
+		buckets <<= 1;
+	}
+
+	cache->buckets = (node_t**)calloc(buckets, sizeof(node_t*));
+	cache->pool = (uint8_t*)malloc(capacity * node_size);
+	if (!cache->buckets || !cache->pool) {
+		free(cache->buckets);
+		free(cache->pool);
+		memset(cache, 0x00, sizeof(lru_cache_t));
+		return -1;
+	}
+
+	cache->key_size = key_size;
+	cache->value_size = value_size;
+	cache->capacity = capacity;
+	cache->bucket_mask = buckets - 1;
+	cache->hash = hash;
+
+	/* the pool nodes belong to the cache: they are linked by hand and the list is never cleared */
+	list_create(&cache->list, node_size - sizeof(node_t));
+	for (i = 0; i < capacity; i++) {
+		node = (node_t*)(cache->pool + i * node_size);
+		node->previous = previous;
+		node->next = NULL;
+		if (previous) {
+			previous->next = node;
+		}
+		previous = node;
+	}
+	cache->list.begin = (node_t*)cache->pool;
+	cache->list.end = previous;
+	cache->list.size = (int)capacity;
+
+	return 0;
+}
+
+void lru_cache_destroy(lru_cache_t* cache)
+{
+	free(cache->buckets);
+	free(cache->pool);
+	memset(cache, 0x00, sizeof(lru_cache_t));
+}
+
+void lru_cache_clear(lru_cache_t* cache)
+{
+	memset(cache->buckets, 0x00, (cache->bucket_mask + 1) * sizeof(node_t*));
+	cache->size = 0;
+}
+
+void lru_cache_set_eviction_callback(lru_cache_t* cache, lru_cache_evict_t on_evict, void* ctx)
+{
+	cache->on_evict = on_evict;
+	cache->evict_ctx = ctx;
+}
+
+void* lru_cache_get(lru_cache_t* cache, const void* key)
+{
+	node_t** link = _lru_cache_find(cache, key, cache->hash(key, cache->key_size));
+
+	if (!link) {
+		cache->misses++;
+		return NULL;
+	}
+
+	cache->hits++;
+	list_move_to_front(&cache->list, *link);
+
+	return _lru_cache_value(cache, cache->list.begin);
+}
+
+void* lru_cache_peek(lru_cache_t* cache, const void* key)
+{
+	node_t** link = _lru_cache_find(cache, key, cache->hash(key, cache->key_size));
+
+	return link ? _lru_cache_value(cache, *link) : NULL;
+}
+
+bool lru_cache_contains(lru_cache_t* cache, const void* key)
+{
+	return lru_cache_peek(cache, key) != NULL;
+}
+
+int lru_cache_put(lru_cache_t* cache, const void* key, const void* value)
+{
+	uint32_t hash;
+	node_t** link;
+	node_t* node;
+	lru_cache_entry_t* entry;
+
+	if (!key || !value) return -1;
+
+	hash = cache->hash(key, cache->key_size);
+	link = _lru_cache_find(cache, key, hash);
+
+	if (link) {
+		node = *link;
+	}
+	else {
+		/* either the least recently used entry or a free node */
+		node = cache->list.end;
+
+		if (cache->size == cache->capacity) {
+			if (cache->on_evict) {
+				cache->on_evict(_lru_cache_key(node), _lru_cache_value(cache, node), cache->evict_ctx);
+			}
+			_lru_cache_unchain(cache, node);
+			cache->evictions++;
+		}
+		else {
+			cache->size++;
+		}
+
+		entry = _lru_cache_entry(node);
+		entry->hash = hash;
+		memcpy(_lru_cache_key(node), key, cache->key_size);
+		link = _lru_cache_bucket(cache, hash);
+		entry->chain = *link;
+		*link = node;
+	}
+
+	memcpy(_lru_cache_value(cache, node), value, cache->value_size);
+	list_move_to_front(&cache->list, node);
+
+	return 0;
+}
+
+int lru_cache_erase(lru_cache_t* cache, const void* key)
+{
+	node_t** link = _lru_cache_find(cache, key, cache->hash(key, cache->key_size));
+	node_t* node;
+
+	if (!link) return -1;
+
+	node = *link;
+	*link = _lru_cache_entry(node)->chain;
+
+	/* back with the free nodes */
+	list_move_to_back(&cache->list, node);
+	cache->size--;
+
+	return 0;
+}
+
+size_t lru_cache_size(lru_cache_t* cache)
+{
+	return cache->size;
+}
+
+void lru_cache_reset_stats(lru_cache_t* cache)
+{
+	cache->hits = 0;
+	cache->misses = 0;
+	cache->evictions = 0;
+}
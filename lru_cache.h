@@ -0,0 +1,198 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file lru_cache.h
+@author Tony Pottier
+@brief Fixed capacity key/value cache with least recently used eviction
+
+The cache keeps its entries in a list_t ordered by recency: the most recently
+used entry is at the beginning of the list and the least recently used one at
+its end. A hash index maps keys to their node so that get, put and erase are
+all O(1).
+
+Every node is allocated in a single pool when the cache is created and
+unused nodes wait at the end of the recency list. Once the cache is created,
+get, put and erase never call malloc or free: a put on a full cache recycles
+the node of the entry it evicts.
+
+Keys and values are fixed size and copied in the cache. Keys are hashed with
+FNV-1a by default and compared with memcmp, so they must not contain padding
+bytes with undefined content.
+
+@code{c}
+lru_cache_t cache;
+lru_cache_create(&cache, sizeof(uint64_t), sizeof(user_t), 4096);
+lru_cache_put(&cache, &id, &user);
+user_t* cached = (user_t*)lru_cache_get(&cache, &id);
+lru_cache_destroy(&cache);
+@endcode
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _LRU_CACHE_H_
+#define _LRU_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t (*lru_cache_hash_t)(const void* key, size_t key_size);
+typedef void (*lru_cache_evict_t)(const void* key, void* value, void* ctx);
+
+typedef struct lru_cache_t {
+	size_t key_size;
+	size_t value_size;
+	size_t capacity;
+	size_t size;
+	list_t list;		/* recency order: entries in use first, unused pool nodes last */
+	node_t** buckets;	/* hash index, chained through the entries */
+	size_t bucket_mask;
+	uint8_t* pool;
+	lru_cache_hash_t hash;
+	lru_cache_evict_t on_evict;
+	void* evict_ctx;
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+}lru_cache_t;
+
+
+/**
+  * @brief initialize a cache holding up to capacity entries, with keys hashed by FNV-1a.
+  * All the memory the cache will ever need is allocated here.
+  * @param      cache: pointer to the lru_cache_t struct to be initialized
+  * @param		key_size: size in bytes of the keys
+  * @param		value_size: size in bytes of the values
+  * @param		capacity: maximum number of entries held by the cache
+  * @return		0: success
+  *				-1: failure
+  */
+int lru_cache_create(lru_cache_t* cache, size_t key_size, size_t value_size, size_t capacity);
+
+/**
+  * @brief initialize a cache holding up to capacity entries, with keys hashed by the given function
+  * @param      cache: pointer to the lru_cache_t struct to be initialized
+  * @param		key_size: size in bytes of the keys
+  * @param		value_size: size in bytes of the values
+  * @param		capacity: maximum number of entries held by the cache
+  * @param		hash: hash function for keys. Keys are still compared with memcmp
+  * @return		0: success
+  *				-1: failure
+  */
+int lru_cache_create_with(lru_cache_t* cache, size_t key_size, size_t value_size, size_t capacity, lru_cache_hash_t hash);
+
+/**
+  * @brief remove all entries and free all memory held by the cache, and bzero's the struct lru_cache_t
+  * @param  cache: the cache to perform the operation on
+  * @note the eviction callback is not called for the entries still in the cache
+  */
+void lru_cache_destroy(lru_cache_t* cache);
+
+/**
+  * @brief remove all entries from the cache. Statistics are left untouched.
+  * @param  cache: the cache to perform the operation on
+  * @note the eviction callback is not called for the removed entries
+  */
+void lru_cache_clear(lru_cache_t* cache);
+
+/**
+  * @brief register a function called whenever an entry is evicted to make room for a new one.
+  * The callback runs before the entry is overwritten, and must not access the cache.
+  * @param  cache: the cache to perform the operation on
+  * @param  on_evict: the callback, or NULL to remove it
+  * @param  ctx: passed as is to the callback
+  */
+void lru_cache_set_eviction_callback(lru_cache_t* cache, lru_cache_evict_t on_evict, void* ctx);
+
+/**
+  * @brief look up a key and mark its entry as the most recently used one
+  * @param  cache: the cache to perform the operation on
+  * @param  key: the key to look for
+  * @return void*: pointer to the value stored in the cache, valid until the entry is evicted or erased
+  *         NULL: key not found
+  * @note updates the hits and misses counters
+  */
+void* lru_cache_get(lru_cache_t* cache, const void* key);
+
+/**
+  * @brief look up a key without changing the recency order nor the statistics
+  * @param  cache: the cache to perform the operation on
+  * @param  key: the key to look for
+  * @return void*: pointer to the value stored in the cache
+  *         NULL: key not found
+  */
+void* lru_cache_peek(lru_cache_t* cache, const void* key);
+
+/**
+  * @brief insert a key/value pair, or update the value of an existing key, and mark the entry as
+  * the most recently used one. When the cache is full the least recently used entry is evicted.
+  * @param  cache: the cache to perform the operation on
+  * @param  key: the key to insert
+  * @param  value: the value copied in the cache
+  * @return 0: success
+  *         -1: failure
+  */
+int lru_cache_put(lru_cache_t* cache, const void* key, const void* value);
+
+/**
+  * @brief remove a key from the cache. The eviction callback is not called.
+  * @param  cache: the cache to perform the operation on
+  * @param  key: the key to remove
+  * @return 0: success
+  *         -1: key not found
+  */
+int lru_cache_erase(lru_cache_t* cache, const void* key);
+
+/**
+  * @brief check whether the cache holds the given key, without changing the recency order
+  * @param  cache: the cache to perform the operation on
+  * @param  key: the key to look for
+  */
+bool lru_cache_contains(lru_cache_t* cache, const void* key);
+
+/**
+  * @brief number of entries currently held by the cache
+  */
+size_t lru_cache_size(lru_cache_t* cache);
+
+/**
+  * @brief reset the hits, misses and evictions counters
+  */
+void lru_cache_reset_stats(lru_cache_t* cache);
+
+/**
+  * @brief 32 bits FNV-1a hash, the default hash function for keys
+  */
+uint32_t lru_cache_hash_fnv1a(const void* key, size_t key_size);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,309 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file mapped_vector.c
+@author Tony Pottier
+@brief Source code for a persistent vector backed by a memory mapped file
+
+The backing file is laid out as a mapped_vector_header_t padded to
+MAPPED_VECTOR_HEADER_SIZE bytes, followed by capacity elements. The whole file
+is mapped shared so every write lands in the page cache and ends up on disk.
+Growth follows vector.c: the capacity doubles when the vector is full. The
+file is extended with ftruncate and the mapping follows with mremap when
+available, or is simply mapped again otherwise.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* mremap */
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "vector.h"
+#include "mapped_vector.h"
+
+/**
+ * @brief largest capacity whose mapping length fits in a size_t
+ */
+static inline size_t _mapped_vector_max_capacity(size_t size_type)
+{
+	return (SIZE_MAX - MAPPED_VECTOR_HEADER_SIZE) / size_type;
+}
+
+static inline size_t _mapped_vector_length(size_t size_type, size_t capacity)
+{
+	return MAPPED_VECTOR_HEADER_SIZE + capacity * size_type;
+}
+
+static inline void _mapped_vector_set_mapping(mapped_vector_t* vector, void* addr, size_t length)
+{
+	vector->header = (mapped_vector_header_t*)addr;
+	vector->data = (uint8_t*)addr + MAPPED_VECTOR_HEADER_SIZE;
+	vector->length = length;
+}
+
+static inline void* _mapped_vector_at(mapped_vector_t* vector, size_t n)
+{
+	return vector->data + (n * vector->header->size_type);
+}
+
+static int _mapped_vector_resize(mapped_vector_t* vector, size_t new_capacity)
+{
+	size_t old_length = vector->length;
+	size_t new_length;
+	void* addr;
+
+	if (new_capacity > _mapped_vector_max_capacity((size_t)vector->header->size_type)) return -1;
+	new_length = _mapped_vector_length((size_t)vector->header->size_type, new_capacity);
+
+	/* the file must be grown before the mapping, and shrunk after it */
+	if (new_length > old_length && ftruncate(vector->fd, (off_t)new_length) != 0) {
+		return -1;
+	}
+
+#if defined(MREMAP_MAYMOVE)
+	addr = mremap(vector->header, old_length, new_length, MREMAP_MAYMOVE);
+	if (addr == MAP_FAILED) {
+		return -1;
+	}
+#else
+	addr = mmap(NULL, new_length, PROT_READ | PROT_WRITE, MAP_SHARED, vector->fd, 0);
+	if (addr == MAP_FAILED) {
+		return -1;
+	}
+	munmap(vector->header, old_length);
+#endif
+
+	_mapped_vector_set_mapping(vector, addr, new_length);
+
+	if (new_length < old_length) {
+		/* a failed truncate only wastes disk space: the header is the source of truth */
+		(void)ftruncate(vector->fd, (off_t)new_length);
+	}
+
+	vector->header->capacity = new_capacity;
+
+	return 0;
+}
+
+
+int mapped_vector_open(mapped_vector_t* vector, const char* path, size_t size_type)
+{
+	return mapped_vector_open_with(vector, path, size_type, VECTOR_DEFAULT_INITIAL_SIZE);
+}
+
+int mapped_vector_open_with(mapped_vector_t* vector, const char* path, size_t size_type, size_t capacity)
+{
+	struct stat st;
+	mapped_vector_header_t header;
+	size_t length;
+	void* addr;
+	int fd;
+
+	if (!vector || !path || size_type == 0) return -1;
+	if (capacity < VECTOR_MINIMUM_CAPACITY) capacity = VECTOR_MINIMUM_CAPACITY;
+	if (capacity > _mapped_vector_max_capacity(size_type)) return -1;
+
+	fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) return -1;
+
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		return -1;
+	}
+
+	if (st.st_size == 0) {
+		/* brand new file: write the header and size the file for the initial capacity */
+		memset(&header, 0x00, sizeof(header));
+		header.magic = MAPPED_VECTOR_MAGIC;
+		header.version = MAPPED_VECTOR_VERSION;
+		header.size = 0;
+		header.capacity = capacity;
+		header.size_type = size_type;
+
+		length = _mapped_vector_length(size_type, capacity);
+		if (ftruncate(fd, (off_t)length) != 0 || pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+			close(fd);
+			return -1;
+		}
+	}
+	else {
+		/* existing file: only the header is read, the elements are paged in on demand */
+		if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)
+			|| header.magic != MAPPED_VECTOR_MAGIC
+			|| header.version != MAPPED_VECTOR_VERSION
+			|| header.size_type != size_type
+			|| header.size > header.capacity
+			|| header.capacity > _mapped_vector_max_capacity(size_type)) {
+			close(fd);
+			return -1;
+		}
+
+		length = _mapped_vector_length(size_type, (size_t)header.capacity);
+		if ((size_t)st.st_size < length) {
+			close(fd);
+			return -1;
+		}
+	}
+
+	addr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (addr == MAP_FAILED) {
+		close(fd);
+		return -1;
+	}
+
+	vector->fd = fd;
+	_mapped_vector_set_mapping(vector, addr, length);
+
+	return 0;
+}
+
+void mapped_vector_close(mapped_vector_t* vector)
+{
+	if (vector && vector->header) {
+		munmap(vector->header, vector->length);
+		close(vector->fd);
+	}
+
+	memset(vector, 0x00, sizeof(mapped_vector_t));
+}
+
+int mapped_vector_flush(mapped_vector_t* vector)
+{
+	return msync(vector->header, vector->length, MS_SYNC) == 0 ? 0 : -1;
+}
+
+int mapped_vector_flush_async(mapped_vector_t* vector)
+{
+	return msync(vector->header, vector->length, MS_ASYNC) == 0 ? 0 : -1;
+}
+
+size_t mapped_vector_size(const mapped_vector_t* vector)
+{
+	return (size_t)vector->header->size;
+}
+
+void mapped_vector_clear(mapped_vector_t* vector)
+{
+	vector->header->size = 0;
+}
+
+int mapped_vector_reserve(mapped_vector_t* vector, size_t capacity)
+{
+	if (capacity <= vector->header->capacity) return 0;
+
+	return _mapped_vector_resize(vector, capacity);
+}
+
+int mapped_vector_shrink_to_fit(mapped_vector_t* vector)
+{
+	size_t capacity = (size_t)vector->header->size;
+
+	if (capacity < VECTOR_MINIMUM_CAPACITY) capacity = VECTOR_MINIMUM_CAPACITY;
+	if (capacity == vector->header->capacity) return 0;
+
+	return _mapped_vector_resize(vector, capacity);
+}
+
+int mapped_vector_push_back(mapped_vector_t* vector, const void* data)
+{
+	mapped_vector_header_t* header = vector->header;
+
+	if (header->size >= header->capacity) {
+		if (_mapped_vector_resize(vector, (size_t)header->capacity << 1) != 0) {
+			return -1;
+		}
+		header = vector->header;
+	}
+
+	memcpy(_mapped_vector_at(vector, (size_t)header->size), data, (size_t)header->size_type);
+
+	/* size is only bumped once the element is in place */
+	header->size++;
+
+	return 0;
+}
+
+int mapped_vector_pop_back(mapped_vector_t* vector, void* data)
+{
+	mapped_vector_header_t* header = vector->header;
+
+	if (header->size == 0) return -1;
+
+	/* optional: get the pop'd data back */
+	if (data) {
+		memcpy(data, _mapped_vector_at(vector, (size_t)header->size - 1), (size_t)header->size_type);
+	}
+
+	header->size--;
+
+	return 0;
+}
+
+int mapped_vector_assign(mapped_vector_t* vector, size_t n, const void* data)
+{
+	if (n >= vector->header->size) return -1;
+
+	memcpy(_mapped_vector_at(vector, n), data, (size_t)vector->header->size_type);
+
+	return 0;
+}
+
+int mapped_vector_sort(mapped_vector_t* vector, int (*comp)(const void*, const void*))
+{
+	qsort(vector->data, (size_t)vector->header->size, (size_t)vector->header->size_type, comp);
+	return 0;
+}
+
+void* mapped_vector_at(mapped_vector_t* vector, size_t n)
+{
+	if (n >= vector->header->size) return NULL;
+
+	return _mapped_vector_at(vector, n);
+}
+
+void* mapped_vector_front(mapped_vector_t* vector)
+{
+	if (vector->header->size) {
+		return _mapped_vector_at(vector, 0);
+	}
+	else {
+		return NULL;
+	}
+}
+
+void* mapped_vector_back(mapped_vector_t* vector)
+{
+	if (vector->header->size) {
+		return _mapped_vector_at(vector, (size_t)vector->header->size - 1);
+	}
+	else {
+		return NULL;
+	}
+}
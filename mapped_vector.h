@@ -0,0 +1,217 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file mapped_vector.h
+@author Tony Pottier
+@brief Defines a persistent vector whose storage is a memory mapped file
+
+A mapped vector behaves like vector.h but its elements live in a file. The
+file starts with a small header holding the vector's size, capacity and
+size_type, followed by the elements themselves. Reopening an existing file
+is instantaneous: nothing is read upfront and the kernel pages data in
+lazily as it gets accessed.
+
+mapped_vector.h requires a POSIX system (mmap, ftruncate, msync). On Linux
+the mapping is grown in place with mremap.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _MAPPED_VECTOR_H_
+#define _MAPPED_VECTOR_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAPPED_VECTOR_MAGIC 0x56434453 /* "SDCV" */
+#define MAPPED_VECTOR_VERSION 1
+
+/* elements start at this offset in the file so they are suitably aligned */
+#define MAPPED_VECTOR_HEADER_SIZE 64
+
+typedef struct mapped_vector_header_t {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+	uint64_t capacity;
+	uint64_t size_type;
+}mapped_vector_header_t;
+
+typedef struct mapped_vector_t {
+	mapped_vector_header_t* header;
+	uint8_t* data;
+	size_t length;
+	int fd;
+}mapped_vector_t;
+
+
+/**
+  * @brief open a mapped vector stored in the given file, creating it if it does not exist.
+  * A newly created file gets an initial capacity of VECTOR_DEFAULT_INITIAL_SIZE.
+  * @param      vector: pointer to the mapped_vector_t struct to be initialized
+  * @param		path: path to the backing file
+  * @param		size_type: size in bytes of the elements to be stored
+  * @return		0: success
+  *				-1: failure, including an existing file holding elements of a different size_type
+  */
+int mapped_vector_open(mapped_vector_t* vector, const char* path, size_t size_type);
+
+/**
+  * @brief open a mapped vector stored in the given file, creating it with the specified capacity
+  * if it does not exist. The capacity of an existing file is left untouched.
+  * @param      vector: pointer to the mapped_vector_t struct to be initialized
+  * @param		path: path to the backing file
+  * @param		size_type: size in bytes of the elements to be stored
+  * @param		capacity: initial capacity in number of elements of a new file
+  * @return		0: success
+  *				-1: failure
+  */
+int mapped_vector_open_with(mapped_vector_t* vector, const char* path, size_t size_type, size_t capacity);
+
+/**
+  * @brief unmap the vector and close its backing file. The file is kept on disk.
+  * @param  vector: the vector to perform the operation on
+  * @note modified pages are written back by the kernel at its own pace. Call
+  * mapped_vector_flush beforehand if the data must be on disk when close returns.
+  */
+void mapped_vector_close(mapped_vector_t* vector);
+
+/**
+  * @brief synchronously write all modified pages back to the backing file
+  * @param		vector: the vector to perform the operation on
+  * @return		0: success
+  *				-1: failure
+  */
+int mapped_vector_flush(mapped_vector_t* vector);
+
+/**
+  * @brief schedule all modified pages to be written back to the backing file without waiting
+  * @param		vector: the vector to perform the operation on
+  * @return		0: success
+  *				-1: failure
+  */
+int mapped_vector_flush_async(mapped_vector_t* vector);
+
+/**
+  * @brief number of elements stored in the vector
+  * @param		vector: the vector to perform the operation on
+  */
+size_t mapped_vector_size(const mapped_vector_t* vector);
+
+/**
+  * @brief clears all elements of the vector. The file keeps its capacity.
+  * @param  vector: the vector to perform the operation on
+  */
+void mapped_vector_clear(mapped_vector_t* vector);
+
+/**
+  * @brief grow the backing file so it can hold at least capacity elements
+  * @param		vector: the vector to perform the operation on
+  * @param		capacity: number of elements
+  * @return		0: success
+  *				-1: failure
+  */
+int mapped_vector_reserve(mapped_vector_t* vector, size_t capacity);
+
+/**
+  * @brief truncate the backing file to match the exact number of elements it contains
+  * @param		vector: the vector to perform the operation on
+  * @return		0: success
+  *				-1: failure
+  */
+int mapped_vector_shrink_to_fit(mapped_vector_t* vector);
+
+/**
+  * @brief add data to the end of the vector, doubling the backing file if it is full
+  * @param		vector: the vector to perform the operation on
+  * @param		data: reference to the vector's data type holding the value to be added
+  * @return		0: success
+  *				-1: failure
+  */
+int mapped_vector_push_back(mapped_vector_t* vector, const void* data);
+
+/**
+  * @brief remove the last value of the given vector
+  * data is optional. A NULL value is acceptable.
+  * @param		vector: the vector to perform the operation on
+  * @param		data: reference to the vector's data type where the poped value will be copied
+  * @return		0: success
+  *				-1: failure
+  */
+int mapped_vector_pop_back(mapped_vector_t* vector, void* data);
+
+/**
+  * @brief assign the given value to the data located at the specified index
+  * @param		vector: the vector to perform the operation on
+  * @param		n: the 0 indexed n th value
+  * @param		data: reference to the vector's data type
+  * @return		0: success
+  *				-1: failure
+  */
+int mapped_vector_assign(mapped_vector_t* vector, size_t n, const void* data);
+
+/**
+ * @brief sort the given vector according to the comparator passed as argument
+ * @param  vector: the vector to perform the operation on
+ * @param  comp: a standard comparator function
+ * @return 0: success
+ *         -1: failure
+ */
+int mapped_vector_sort(mapped_vector_t* vector, int (*comp)(const void*, const void*));
+
+/**
+  * @brief access the vector's nth value
+  * @param		vector: the vector to perform the operation on
+  * @param		n: the 0 indexed n th value
+  * @return		void*: pointer to the data
+  *				NULL: failure
+  * @warning the pointer is invalidated whenever the vector grows or shrinks as the mapping may move
+  */
+void* mapped_vector_at(mapped_vector_t* vector, size_t n);
+
+/**
+  * @brief access the vector's first value
+  * @param		vector: the vector to perform the operation on
+  * @return		void*: pointer to the data
+  *				NULL: failure
+  */
+void* mapped_vector_front(mapped_vector_t* vector);
+
+/**
+  * @brief access the vector's last value
+  * @param		vector: the vector to perform the operation on
+  * @return		void*: pointer to the data
+  *				NULL: failure
+  */
+void* mapped_vector_back(mapped_vector_t* vector);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
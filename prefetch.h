@@ -0,0 +1,49 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file prefetch.h
+@author Tony Pottier
+@brief Portable software prefetch hint used by the linked containers
+
+STDCONTAINERS_PREFETCH(addr) asks the CPU to start loading the cache line
+holding addr. It is only a hint: it never faults, even on a NULL pointer, and
+compiles to nothing on toolchains without a prefetch intrinsic.
+Define STDCONTAINERS_NO_PREFETCH to turn all hints off.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _PREFETCH_H_
+#define _PREFETCH_H_
+
+#if defined(STDCONTAINERS_NO_PREFETCH)
+#define STDCONTAINERS_PREFETCH(addr) ((void)0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define STDCONTAINERS_PREFETCH(addr) __builtin_prefetch((const void*)(addr), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#define STDCONTAINERS_PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
+#else
+#define STDCONTAINERS_PREFETCH(addr) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,336 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file snapshot.c
+@author Tony Pottier
+@brief Source code for binary snapshots of vectors, lists and forward lists
+
+A vector's data is already contiguous so it is written and read with a single
+call. Lists are streamed through a SNAPSHOT_BUFFER_SIZE buffer so that the
+file descriptor sees a few large sequential writes instead of one tiny write
+per node.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include "snapshot.h"
+
+typedef struct snapshot_buffer_t {
+	int fd;
+	size_t used;
+	size_t length;
+	uint8_t* data;
+}snapshot_buffer_t;
+
+
+static int _snapshot_write(int fd, const void* buffer, size_t length)
+{
+	const uint8_t* p = (const uint8_t*)buffer;
+
+	while (length) {
+		ssize_t n = write(fd, p, length);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		p += n;
+		length -= (size_t)n;
+	}
+
+	return 0;
+}
+
+static int _snapshot_read(int fd, void* buffer, size_t length)
+{
+	uint8_t* p = (uint8_t*)buffer;
+
+	while (length) {
+		ssize_t n = read(fd, p, length);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		if (n == 0) {
+			/* truncated snapshot */
+			return -1;
+		}
+		p += n;
+		length -= (size_t)n;
+	}
+
+	return 0;
+}
+
+static int _snapshot_write_header(int fd, snapshot_kind_t kind, size_t size_type, size_t size)
+{
+	snapshot_header_t header;
+
+	memset(&header, 0x00, sizeof(header));
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.kind = (uint16_t)kind;
+	header.size_type = size_type;
+	header.size = size;
+
+	return _snapshot_write(fd, &header, sizeof(header));
+}
+
+static int _snapshot_read_header(int fd, snapshot_kind_t kind, snapshot_header_t* header)
+{
+	if (_snapshot_read(fd, header, sizeof(snapshot_header_t)) != 0) return -1;
+
+	if (header->magic != SNAPSHOT_MAGIC || header->version != SNAPSHOT_VERSION || header->kind != kind) {
+		return -1;
+	}
+
+	if (header->size_type == 0 || header->size_type > SIZE_MAX) return -1;
+
+	/* a corrupt or hostile header must not wrap size * size_type, nor exceed the int sizes and indices of the containers */
+	if (header->size > INT_MAX || header->size > SIZE_MAX / header->size_type) return -1;
+
+	return 0;
+}
+
+static int _snapshot_buffer_create(snapshot_buffer_t* buffer, int fd, size_t size_type)
+{
+	/* the buffer always holds at least one element */
+	buffer->length = size_type > SNAPSHOT_BUFFER_SIZE ? size_type : SNAPSHOT_BUFFER_SIZE;
+	buffer->length -= buffer->length % size_type;
+	buffer->fd = fd;
+	buffer->used = 0;
+	buffer->data = (uint8_t*)malloc(buffer->length);
+
+	return buffer->data ? 0 : -1;
+}
+
+static inline void _snapshot_buffer_destroy(snapshot_buffer_t* buffer)
+{
+	free(buffer->data);
+	buffer->data = NULL;
+}
+
+static inline int _snapshot_buffer_flush(snapshot_buffer_t* buffer)
+{
+	int ret = _snapshot_write(buffer->fd, buffer->data, buffer->used);
+	buffer->used = 0;
+	return ret;
+}
+
+static inline int _snapshot_buffer_append(snapshot_buffer_t* buffer, const void* data, size_t size_type)
+{
+	if (buffer->used + size_type > buffer->length) {
+		if (_snapshot_buffer_flush(buffer) != 0) return -1;
+	}
+
+	memcpy(buffer->data + buffer->used, data, size_type);
+	buffer->used += size_type;
+
+	return 0;
+}
+
+/**
+ * @brief refills the buffer with as many whole elements as possible, up to remaining
+ * @return number of elements now available in the buffer, 0 on failure
+ */
+static size_t _snapshot_buffer_fill(snapshot_buffer_t* buffer, size_t size_type, uint64_t remaining)
+{
+	size_t count = buffer->length / size_type;
+
+	if ((uint64_t)count > remaining) {
+		count = (size_t)remaining;
+	}
+
+	if (_snapshot_read(buffer->fd, buffer->data, count * size_type) != 0) {
+		return 0;
+	}
+
+	return count;
+}
+
+
+int vector_save(const vector_t* vector, int fd)
+{
+	if (_snapshot_write_header(fd, SNAPSHOT_VECTOR, vector->size_type, vector->size) != 0) {
+		return -1;
+	}
+
+	return _snapshot_write(fd, vector->data, vector->size * vector->size_type);
+}
+
+int vector_load(vector_t* vector, int fd)
+{
+	snapshot_header_t header;
+
+	if (!vector || _snapshot_read_header(fd, SNAPSHOT_VECTOR, &header) != 0) return -1;
+
+	if (vector_create_with(vector, (size_t)header.size_type, (size_t)header.size) != 0) {
+		return -1;
+	}
+
+	/* elements go straight into the vector's buffer */
+	if (_snapshot_read(fd, vector->data, (size_t)(header.size * header.size_type)) != 0) {
+		vector_destroy(vector);
+		return -1;
+	}
+
+	vector->size = (size_t)header.size;
+
+	return 0;
+}
+
+
+int list_save(const list_t* list, int fd)
+{
+	snapshot_buffer_t buffer;
+	node_t* node;
+	int ret = 0;
+
+	if (_snapshot_write_header(fd, SNAPSHOT_LIST, list->size_type, (size_t)list->size) != 0) {
+		return -1;
+	}
+
+	if (list->size == 0) return 0;
+
+	if (_snapshot_buffer_create(&buffer, fd, list->size_type) != 0) return -1;
+
+	for (node = list->begin; node != NULL && ret == 0; node = node->next) {
+		ret = _snapshot_buffer_append(&buffer, node->data, list->size_type);
+	}
+
+	if (ret == 0) {
+		ret = _snapshot_buffer_flush(&buffer);
+	}
+
+	_snapshot_buffer_destroy(&buffer);
+
+	return ret;
+}
+
+int list_load(list_t* list, int fd)
+{
+	snapshot_buffer_t buffer;
+	snapshot_header_t header;
+	uint64_t remaining;
+	size_t count, i;
+
+	if (!list || _snapshot_read_header(fd, SNAPSHOT_LIST, &header) != 0) return -1;
+
+	list_create(list, (size_t)header.size_type);
+
+	if (header.size == 0) return 0;
+
+	if (_snapshot_buffer_create(&buffer, fd, list->size_type) != 0) return -1;
+
+	remaining = header.size;
+	while (remaining) {
+		count = _snapshot_buffer_fill(&buffer, list->size_type, remaining);
+		if (count == 0) break;
+
+		for (i = 0; i < count; i++) {
+			if (!list_push_back(list, buffer.data + i * list->size_type)) break;
+		}
+		if (i != count) break;
+
+		remaining -= count;
+	}
+
+	_snapshot_buffer_destroy(&buffer);
+
+	if (remaining) {
+		list_destroy(list);
+		return -1;
+	}
+
+	return 0;
+}
+
+
+int forward_list_save(const forward_list_t* list, int fd)
+{
+	snapshot_buffer_t buffer;
+	forward_node_t* node;
+	int ret = 0;
+
+	if (_snapshot_write_header(fd, SNAPSHOT_FORWARD_LIST, list->size_type, (size_t)list->size) != 0) {
+		return -1;
+	}
+
+	if (list->size == 0) return 0;
+
+	if (_snapshot_buffer_create(&buffer, fd, list->size_type) != 0) return -1;
+
+	for (node = list->begin; node != NULL && ret == 0; node = node->next) {
+		ret = _snapshot_buffer_append(&buffer, node->data, list->size_type);
+	}
+
+	if (ret == 0) {
+		ret = _snapshot_buffer_flush(&buffer);
+	}
+
+	_snapshot_buffer_destroy(&buffer);
+
+	return ret;
+}
+
+int forward_list_load(forward_list_t* list, int fd)
+{
+	snapshot_buffer_t buffer;
+	snapshot_header_t header;
+	uint64_t remaining;
+	size_t count, i;
+
+	if (!list || _snapshot_read_header(fd, SNAPSHOT_FORWARD_LIST, &header) != 0) return -1;
+
+	forward_list_create(list, (size_t)header.size_type);
+
+	if (header.size == 0) return 0;
+
+	if (_snapshot_buffer_create(&buffer, fd, list->size_type) != 0) return -1;
+
+	remaining = header.size;
+	while (remaining) {
+		count = _snapshot_buffer_fill(&buffer, list->size_type, remaining);
+		if (count == 0) break;
+
+		for (i = 0; i < count; i++) {
+			if (!forward_list_push_back(list, buffer.data + i * list->size_type)) break;
+		}
+		if (i != count) break;
+
+		remaining -= count;
+	}
+
+	_snapshot_buffer_destroy(&buffer);
+
+	if (remaining) {
+		forward_list_destroy(list);
+		return -1;
+	}
+
+	return 0;
+}
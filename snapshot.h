@@ -0,0 +1,136 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file snapshot.h
+@author Tony Pottier
+@brief Binary snapshots of vectors, lists and forward lists
+
+A snapshot is a snapshot_header_t followed by the elements' payloads written
+back to back, in container order. Lists are stored exactly like vectors: no
+pointer ever makes it to the file. Snapshots are written in the host's
+byte order and are meant to be reloaded on the same architecture.
+
+Snapshots are read from and written to POSIX file descriptors, which makes
+them usable with regular files, pipes and sockets alike.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+#include <stdint.h>
+#include "vector.h"
+#include "list.h"
+#include "forward_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SNAPSHOT_MAGIC 0x53434453 /* "SDCS" */
+#define SNAPSHOT_VERSION 1
+
+/* size of the intermediate buffer used to stream lists in and out */
+#define SNAPSHOT_BUFFER_SIZE (1 << 16)
+
+typedef enum snapshot_kind_t {
+	SNAPSHOT_VECTOR = 1,
+	SNAPSHOT_LIST = 2,
+	SNAPSHOT_FORWARD_LIST = 3
+}snapshot_kind_t;
+
+typedef struct snapshot_header_t {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t kind;
+	uint64_t size_type;
+	uint64_t size;
+}snapshot_header_t;
+
+
+/**
+  * @brief write a snapshot of the vector to the given file descriptor
+  * @param		vector: the vector to save
+  * @param		fd: file descriptor open for writing
+  * @return		0: success
+  *				-1: failure
+  */
+int vector_save(const vector_t* vector, int fd);
+
+/**
+  * @brief initialize a vector from a snapshot read from the given file descriptor.
+  * The elements are read straight into the vector's buffer.
+  * @param      vector: pointer to the vector_t struct to be initialized
+  * @param		fd: file descriptor open for reading
+  * @return		0: success
+  *				-1: failure. The vector is left uninitialized
+  * @warning the vector must not already be holding data or it will be leaked
+  */
+int vector_load(vector_t* vector, int fd);
+
+/**
+  * @brief write a snapshot of the list to the given file descriptor
+  * @param		list: the list to save
+  * @param		fd: file descriptor open for writing
+  * @return		0: success
+  *				-1: failure
+  * @note the list's comparator is not part of the snapshot
+  */
+int list_save(const list_t* list, int fd);
+
+/**
+  * @brief initialize a list from a snapshot read from the given file descriptor
+  * @param      list: pointer to the list_t struct to be initialized
+  * @param		fd: file descriptor open for reading
+  * @return		0: success
+  *				-1: failure. The list is left uninitialized
+  * @warning the list must not already be holding data or it will be leaked
+  */
+int list_load(list_t* list, int fd);
+
+/**
+  * @brief write a snapshot of the forward list to the given file descriptor
+  * @param		list: the forward list to save
+  * @param		fd: file descriptor open for writing
+  * @return		0: success
+  *				-1: failure
+  * @note the list's comparator is not part of the snapshot
+  */
+int forward_list_save(const forward_list_t* list, int fd);
+
+/**
+  * @brief initialize a forward list from a snapshot read from the given file descriptor
+  * @param      list: pointer to the forward_list_t struct to be initialized
+  * @param		fd: file descriptor open for reading
+  * @return		0: success
+  *				-1: failure. The list is left uninitialized
+  * @warning the list must not already be holding data or it will be leaked
+  */
+int forward_list_load(forward_list_t* list, int fd);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
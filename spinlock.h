@@ -0,0 +1,112 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file spinlock.h
+@author Tony Pottier
+@brief Header-only ticket spinlock used by the concurrent containers
+
+A ticket lock hands the lock over in strict arrival order, so that no thread
+starves under contention. Waiting threads spin on the owner field with a CPU
+pause hint and yield their time slice after SPINLOCK_SPIN_COUNT iterations,
+which keeps oversubscribed machines (more threads than cores) from burning
+whole time slices while the lock holder is preempted.
+
+Critical sections must stay short: use a pthread mutex or rwlock for long
+ones.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _SPINLOCK_H_
+#define _SPINLOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sched.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SPINLOCK_SPIN_COUNT
+#define SPINLOCK_SPIN_COUNT 128
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SPINLOCK_PAUSE() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define SPINLOCK_PAUSE() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define SPINLOCK_PAUSE() ((void)0)
+#endif
+
+typedef struct spinlock_t {
+	uint32_t next;
+	uint32_t owner;
+}spinlock_t;
+
+
+static inline void spinlock_init(spinlock_t* lock)
+{
+	lock->next = 0;
+	lock->owner = 0;
+}
+
+static inline void spinlock_lock(spinlock_t* lock)
+{
+	uint32_t ticket = __atomic_fetch_add(&lock->next, 1, __ATOMIC_RELAXED);
+	int spins = 0;
+
+	while (__atomic_load_n(&lock->owner, __ATOMIC_ACQUIRE) != ticket) {
+		if (++spins < SPINLOCK_SPIN_COUNT) {
+			SPINLOCK_PAUSE();
+		}
+		else {
+			spins = 0;
+			sched_yield();
+		}
+	}
+}
+
+/**
+ * @brief take the lock only if it is free
+ * @return true: the lock is now held by the caller
+ */
+static inline bool spinlock_trylock(spinlock_t* lock)
+{
+	uint32_t owner = __atomic_load_n(&lock->owner, __ATOMIC_RELAXED);
+
+	return __atomic_compare_exchange_n(&lock->next, &owner, owner + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+static inline void spinlock_unlock(spinlock_t* lock)
+{
+	/* only the holder writes owner: a plain increment published with release semantics is enough */
+	__atomic_store_n(&lock->owner, lock->owner + 1, __ATOMIC_RELEASE);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file stats.h
+@author Tony Pottier
+@brief Opt-in allocation and operation counters for vectors, lists and forward lists
+
+When the library is compiled with STDCONTAINERS_STATS defined, vector_t,
+list_t and forward_list_t embed a container_stats_t recording what they did
+over their lifetime: memory allocations and frees, bytes requested, reallocs,
+grow and shrink events, the largest size reached and the number of
+comparator calls made by sorting, searching and ordered insertion. Read them
+with vector_get_stats, list_get_stats and forward_list_get_stats.
+
+Without STDCONTAINERS_STATS, the counters do not exist and every counting
+macro compiles to nothing. STDCONTAINERS_STATS changes the layout of the
+container structs: the library and all code using it must be compiled with
+the same setting.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _STATS_H_
+#define _STATS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct container_stats_t {
+	uint64_t allocations;
+	uint64_t frees;
+	uint64_t bytes_allocated;
+	uint64_t reallocs;
+	uint64_t grows;
+	uint64_t shrinks;
+	uint64_t max_size;
+	uint64_t comparisons;
+}container_stats_t;
+
+#if defined(STDCONTAINERS_STATS)
+
+#if defined(_MSC_VER)
+#define STDCONTAINERS_THREAD_LOCAL __declspec(thread)
+#else
+#define STDCONTAINERS_THREAD_LOCAL __thread
+#endif
+
+#define STDCONTAINERS_STATS_ADD(container, field, n) ((container)->stats.field += (uint64_t)(n))
+#define STDCONTAINERS_STATS_INC(container, field) ((container)->stats.field++)
+#define STDCONTAINERS_STATS_MAX_SIZE(container) \
+	do { \
+		if ((uint64_t)(container)->size > (container)->stats.max_size) (container)->stats.max_size = (uint64_t)(container)->size; \
+	} while (0)
+
+/* comparators are plain function pointers without a context argument: comparator calls are
+counted by a trampoline which finds the real comparator and the counter in thread local storage */
+typedef int (*container_stats_comparator_t)(const void*, const void*);
+
+static inline container_stats_comparator_t* _container_stats_comparator(void)
+{
+	static STDCONTAINERS_THREAD_LOCAL container_stats_comparator_t comp;
+	return &comp;
+}
+
+static inline uint64_t** _container_stats_counter(void)
+{
+	static STDCONTAINERS_THREAD_LOCAL uint64_t* counter;
+	return &counter;
+}
+
+static inline int _container_stats_trampoline(const void* a, const void* b)
+{
+	(**_container_stats_counter())++;
+	return (*_container_stats_comparator())(a, b);
+}
+
+static inline container_stats_comparator_t _container_stats_wrap(container_stats_comparator_t comp, uint64_t* counter)
+{
+	if (!comp) return comp;
+	*_container_stats_comparator() = comp;
+	*_container_stats_counter() = counter;
+	return _container_stats_trampoline;
+}
+
+/* replaces comp by a comparator counting its calls in container's stats. Not reentrant: the
+comparator itself must not sort or search another container */
+#define STDCONTAINERS_STATS_COMPARATOR(container, comp) _container_stats_wrap((comp), &(container)->stats.comparisons)
+
+#else
+
+#define STDCONTAINERS_STATS_ADD(container, field, n) ((void)0)
+#define STDCONTAINERS_STATS_INC(container, field) ((void)0)
+#define STDCONTAINERS_STATS_MAX_SIZE(container) ((void)0)
+#define STDCONTAINERS_STATS_COMPARATOR(container, comp) (comp)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
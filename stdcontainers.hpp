@@ -0,0 +1,335 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file stdcontainers.hpp
+@author Tony Pottier
+@brief Thin header-only C++11 wrapper over vector.c and list.c
+
+stdc::vector<T> and stdc::list<T> own a vector_t and a list_t respectively
+and release them when going out of scope. Moving a container only steals its
+pointers, and the underlying C container can be handed over to C code (or
+adopted from it) without copying a single element.
+
+Elements are moved around with memcpy by the C containers, so T must be
+trivially copyable.
+
+@code{cpp}
+stdc::vector<int> v;
+for (int i = 0; i < 10; i++) {
+    v.push_back(rand() % 100);
+}
+std::sort(v.begin(), v.end());
+for (int value : v) {
+    printf("%d ", value);
+}
+@endcode
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _STDCONTAINERS_HPP_
+#define _STDCONTAINERS_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vector.h"
+#include "list.h"
+
+namespace stdc {
+
+template <typename T>
+class vector {
+    static_assert(std::is_trivially_copyable<T>::value, "stdc::vector elements are copied with memcpy and must be trivially copyable");
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    static constexpr std::size_t element_size = sizeof(T);
+
+    vector()
+    {
+        if (vector_create(&v_, element_size) != 0) throw std::bad_alloc();
+    }
+
+    explicit vector(std::size_t capacity)
+    {
+        if (vector_create_with(&v_, element_size, capacity) != 0) throw std::bad_alloc();
+    }
+
+    vector(const vector& other)
+    {
+        if (vector_create_with(&v_, element_size, other.v_.size) != 0) throw std::bad_alloc();
+        std::memcpy(v_.data, other.v_.data, other.v_.size * element_size);
+        v_.size = other.v_.size;
+    }
+
+    vector(vector&& other) noexcept : v_(other.v_)
+    {
+        other.reset();
+    }
+
+    ~vector()
+    {
+        vector_destroy(&v_);
+    }
+
+    vector& operator=(vector other) noexcept
+    {
+        std::swap(v_, other.v_);
+        return *this;
+    }
+
+    /**
+     * @brief take ownership of a vector_t created by C code. raw must hold elements of type T.
+     */
+    static vector adopt(vector_t raw)
+    {
+        if (raw.size_type != element_size) throw std::invalid_argument("stdc::vector::adopt: size_type mismatch");
+        vector v(raw, 0);
+        return v;
+    }
+
+    /**
+     * @brief give up ownership of the underlying vector_t, which must then be destroyed by the caller.
+     * The wrapper is left empty.
+     */
+    vector_t release() noexcept
+    {
+        vector_t raw = v_;
+        reset();
+        return raw;
+    }
+
+    vector_t* c_vector() noexcept { return &v_; }
+    const vector_t* c_vector() const noexcept { return &v_; }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + v_.size; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + v_.size; }
+
+    T* data() noexcept { return reinterpret_cast<T*>(v_.data); }
+    const T* data() const noexcept { return reinterpret_cast<const T*>(v_.data); }
+
+    std::size_t size() const noexcept { return v_.size; }
+    std::size_t capacity() const noexcept { return v_.capacity; }
+    bool empty() const noexcept { return v_.size == 0; }
+
+    T& operator[](std::size_t n) noexcept { return data()[n]; }
+    const T& operator[](std::size_t n) const noexcept { return data()[n]; }
+
+    T& at(std::size_t n)
+    {
+        if (n >= v_.size) throw std::out_of_range("stdc::vector::at");
+        return data()[n];
+    }
+
+    const T& at(std::size_t n) const
+    {
+        if (n >= v_.size) throw std::out_of_range("stdc::vector::at");
+        return data()[n];
+    }
+
+    T& front() noexcept { return data()[0]; }
+    T& back() noexcept { return data()[v_.size - 1]; }
+
+    void push_back(const T& value)
+    {
+        if (vector_push_back(&v_, &value) != 0) throw std::bad_alloc();
+    }
+
+    void push_front(const T& value)
+    {
+        if (vector_push_front(&v_, &value) != 0) throw std::bad_alloc();
+    }
+
+    void pop_back() noexcept { vector_pop_back(&v_, NULL); }
+    void pop_front() noexcept { vector_pop_front(&v_, NULL); }
+    void clear() noexcept { vector_clear(&v_); }
+    void shrink_to_fit() noexcept { vector_shrink_to_fit(&v_); }
+
+    void sort(int (*comp)(const void*, const void*)) noexcept { vector_sort(&v_, comp); }
+
+private:
+    vector(vector_t raw, int) noexcept : v_(raw) {}
+
+    /* leave an empty vector behind that does not own any memory */
+    void reset() noexcept
+    {
+        std::memset(&v_, 0x00, sizeof(vector_t));
+        v_.size_type = element_size;
+    }
+
+    vector_t v_;
+};
+
+
+template <typename T>
+class list {
+    static_assert(std::is_trivially_copyable<T>::value, "stdc::list elements are copied with memcpy and must be trivially copyable");
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    static constexpr std::size_t element_size = sizeof(T);
+
+    template <typename U, typename Node>
+    class basic_iterator {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef U value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef U* pointer;
+        typedef U& reference;
+
+        basic_iterator() noexcept : node_(NULL), list_(NULL) {}
+        basic_iterator(Node* node, const list_t* list) noexcept : node_(node), list_(list) {}
+
+        reference operator*() const noexcept { return *reinterpret_cast<U*>(node_->data); }
+        pointer operator->() const noexcept { return reinterpret_cast<U*>(node_->data); }
+
+        basic_iterator& operator++() noexcept { node_ = node_->next; return *this; }
+        basic_iterator operator++(int) noexcept { basic_iterator it(*this); node_ = node_->next; return it; }
+
+        /* end() holds a NULL node: stepping back from it lands on the list's last element */
+        basic_iterator& operator--() noexcept { node_ = node_ ? node_->previous : list_->end; return *this; }
+        basic_iterator operator--(int) noexcept { basic_iterator it(*this); --(*this); return it; }
+
+        bool operator==(const basic_iterator& other) const noexcept { return node_ == other.node_; }
+        bool operator!=(const basic_iterator& other) const noexcept { return node_ != other.node_; }
+
+        Node* node() const noexcept { return node_; }
+
+    private:
+        Node* node_;
+        const list_t* list_;
+    };
+
+    typedef basic_iterator<T, node_t> iterator;
+    typedef basic_iterator<const T, const node_t> const_iterator;
+
+    list() noexcept
+    {
+        list_create(&l_, element_size);
+    }
+
+    list(const list& other)
+    {
+        list_create(&l_, element_size);
+        l_.comparator = other.l_.comparator;
+        for (const node_t* node = other.l_.begin; node != NULL; node = node->next) {
+            if (!list_push_back(&l_, node->data)) {
+                list_clear(&l_);
+                throw std::bad_alloc();
+            }
+        }
+    }
+
+    list(list&& other) noexcept : l_(other.l_)
+    {
+        other.reset();
+    }
+
+    ~list()
+    {
+        list_destroy(&l_);
+    }
+
+    list& operator=(list other) noexcept
+    {
+        std::swap(l_, other.l_);
+        return *this;
+    }
+
+    /**
+     * @brief take ownership of a list_t created by C code. raw must hold elements of type T.
+     */
+    static list adopt(list_t raw)
+    {
+        if (raw.size_type != element_size) throw std::invalid_argument("stdc::list::adopt: size_type mismatch");
+        list l;
+        l.l_ = raw;
+        return l;
+    }
+
+    /**
+     * @brief give up ownership of the underlying list_t, which must then be destroyed by the caller.
+     * The wrapper is left empty.
+     */
+    list_t release() noexcept
+    {
+        list_t raw = l_;
+        reset();
+        return raw;
+    }
+
+    list_t* c_list() noexcept { return &l_; }
+    const list_t* c_list() const noexcept { return &l_; }
+
+    iterator begin() noexcept { return iterator(l_.begin, &l_); }
+    iterator end() noexcept { return iterator(NULL, &l_); }
+    const_iterator begin() const noexcept { return const_iterator(l_.begin, &l_); }
+    const_iterator end() const noexcept { return const_iterator(NULL, &l_); }
+
+    std::size_t size() const noexcept { return static_cast<std::size_t>(l_.size); }
+    bool empty() const noexcept { return l_.size == 0; }
+
+    T& front() noexcept { return *reinterpret_cast<T*>(l_.begin->data); }
+    T& back() noexcept { return *reinterpret_cast<T*>(l_.end->data); }
+
+    void push_back(const T& value)
+    {
+        if (!list_push_back(&l_, &value)) throw std::bad_alloc();
+    }
+
+    void push_front(const T& value)
+    {
+        if (!list_push_front(&l_, &value)) throw std::bad_alloc();
+    }
+
+    void pop_back() noexcept { list_pop_back(&l_, NULL); }
+    void pop_front() noexcept { list_pop_front(&l_, NULL); }
+    void clear() noexcept { list_clear(&l_); }
+
+    void sort(int (*comp)(const void*, const void*)) noexcept { list_sort_with(&l_, comp); }
+
+private:
+    void reset() noexcept
+    {
+        list_create(&l_, element_size);
+    }
+
+    list_t l_;
+};
+
+}
+
+#endif
@@ -0,0 +1,172 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file topk.c
+@author Tony Pottier
+@brief Source code for the streaming top k accumulator
+
+The heap lives in a vector_t created with a capacity of k, so pushes never
+reallocate. Its root is the worst of the kept elements: a new element
+replaces the root and sinks down to its place, and extraction is a heap sort
+of the k elements.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "topk.h"
+
+#define _TOPK_AT(topk, i) ((topk)->heap.data + (i) * (topk)->heap.size_type)
+
+static inline void _topk_swap(uint8_t* a, uint8_t* b, size_t size_type)
+{
+	uint8_t tmp[64];
+	size_t chunk;
+
+	while (size_type) {
+		chunk = size_type < sizeof(tmp) ? size_type : sizeof(tmp);
+		memcpy(tmp, a, chunk);
+		memcpy(a, b, chunk);
+		memcpy(b, tmp, chunk);
+		a += chunk;
+		b += chunk;
+		size_type -= chunk;
+	}
+}
+
+static void _topk_sift_down(topk_t* topk, size_t root, size_t n)
+{
+	size_t child;
+
+	while ((child = (root << 1) + 1) < n) {
+		if (child + 1 < n && topk->comp(_TOPK_AT(topk, child), _TOPK_AT(topk, child + 1)) < 0) child++;
+		if (topk->comp(_TOPK_AT(topk, root), _TOPK_AT(topk, child)) >= 0) break;
+		_topk_swap(_TOPK_AT(topk, root), _TOPK_AT(topk, child), topk->heap.size_type);
+		root = child;
+	}
+}
+
+static void _topk_sift_up(topk_t* topk, size_t n)
+{
+	size_t parent;
+
+	while (n > 0) {
+		parent = (n - 1) >> 1;
+		if (topk->comp(_TOPK_AT(topk, parent), _TOPK_AT(topk, n)) >= 0) break;
+		_topk_swap(_TOPK_AT(topk, parent), _TOPK_AT(topk, n), topk->heap.size_type);
+		n = parent;
+	}
+}
+
+
+int topk_create(topk_t* topk, size_t size_type, size_t k, int (*comp)(const void*, const void*))
+{
+	if (!topk || !comp) return -1;
+
+	if (vector_create_with(&topk->heap, size_type, k ? k : VECTOR_DEFAULT_INITIAL_SIZE) != 0) return -1;
+	topk->k = k;
+	topk->comp = comp;
+
+	return 0;
+}
+
+void topk_destroy(topk_t* topk)
+{
+	vector_destroy(&topk->heap);
+	memset(topk, 0x00, sizeof(topk_t));
+}
+
+void topk_clear(topk_t* topk)
+{
+	/* not vector_clear: the heap must keep its k slots */
+	topk->heap.size = 0;
+}
+
+int topk_push(topk_t* topk, const void* data)
+{
+	if (topk->heap.size < topk->k) {
+		memcpy(_TOPK_AT(topk, topk->heap.size), data, topk->heap.size_type);
+		topk->heap.size++;
+		_topk_sift_up(topk, topk->heap.size - 1);
+		return 1;
+	}
+
+	if (topk->k == 0 || topk->comp(data, topk->heap.data) >= 0) return 0;
+
+	memcpy(topk->heap.data, data, topk->heap.size_type);
+	_topk_sift_down(topk, 0, topk->heap.size);
+
+	return 1;
+}
+
+size_t topk_push_n(topk_t* topk, const void* data, size_t count)
+{
+	const uint8_t* p = (const uint8_t*)data;
+	size_t kept = 0;
+
+	while (count--) {
+		kept += (size_t)topk_push(topk, p);
+		p += topk->heap.size_type;
+	}
+
+	return kept;
+}
+
+const void* topk_threshold(const topk_t* topk)
+{
+	if (topk->k == 0 || topk->heap.size < topk->k) return NULL;
+	return topk->heap.data;
+}
+
+size_t topk_size(const topk_t* topk)
+{
+	return topk->heap.size;
+}
+
+int topk_extract(topk_t* topk, vector_t* out)
+{
+	size_t i;
+
+	if (!out || out->size_type != topk->heap.size_type) return -1;
+
+	/* heap sort: the root goes to the back, so the kept elements end up in comp's order */
+	for (i = topk->heap.size; i > 1; i--) {
+		_topk_swap(topk->heap.data, _TOPK_AT(topk, i - 1), topk->heap.size_type);
+		_topk_sift_down(topk, 0, i - 1);
+	}
+
+	for (i = 0; i < topk->heap.size; i++) {
+		if (vector_push_back(out, _TOPK_AT(topk, i)) != 0) {
+			/* out of memory: turn the sorted elements back into a heap */
+			for (i = topk->heap.size >> 1; i > 0; i--) {
+				_topk_sift_down(topk, i - 1, topk->heap.size);
+			}
+			return -1;
+		}
+	}
+
+	topk_clear(topk);
+
+	return 0;
+}
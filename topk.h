@@ -0,0 +1,142 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file topk.h
+@author Tony Pottier
+@brief Streaming selection of the k first elements of an unbounded sequence
+
+A topk_t keeps, out of every element pushed into it, the k elements that
+would come first if the whole sequence was sorted with comp. They are held
+in a max heap of k elements: once the heap is full, a single comparison
+against its root rejects any element that cannot make it, so scanning n
+elements costs O(nlogk) in the worst case and close to n comparisons on
+random data. Memory never exceeds k elements, whatever the length of the
+sequence.
+
+Elements are size_type bytes copied in the accumulator, and comp is the
+same qsort-style comparator used by vector_sort. To keep the k largest
+elements, use a comparator sorting in descending order.
+
+@code{c}
+topk_t top;
+topk_create(&top, sizeof(score_t), 100, &score_descending);
+for (size_t i = 0; i < count; i++) {
+    topk_push(&top, &scores[i]);
+}
+vector_t best;
+vector_create(&best, sizeof(score_t));
+topk_extract(&top, &best);
+topk_destroy(&top);
+@endcode
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _TOPK_H_
+#define _TOPK_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "vector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct topk_t {
+	vector_t heap;	/* max heap by comp of the best elements seen so far */
+	size_t k;
+	int (*comp)(const void*, const void*);
+}topk_t;
+
+
+/**
+  * @brief initialize an accumulator keeping the k first elements according to comp.
+  * The k elements are allocated here.
+  * @param      topk: pointer to the topk_t struct to be initialized
+  * @param		size_type: size in bytes of the elements
+  * @param		k: number of elements to keep
+  * @param		comp: a standard comparator function
+  * @return		0: success
+  *				-1: failure
+  */
+int topk_create(topk_t* topk, size_t size_type, size_t k, int (*comp)(const void*, const void*));
+
+/**
+  * @brief free all memory held by the accumulator, and bzero's the struct topk_t
+  * @param  topk: the accumulator to perform the operation on
+  */
+void topk_destroy(topk_t* topk);
+
+/**
+  * @brief forget every element pushed so far. The memory is kept for the next sequence.
+  * @param  topk: the accumulator to perform the operation on
+  */
+void topk_clear(topk_t* topk);
+
+/**
+  * @brief offer an element to the accumulator
+  * @param  topk: the accumulator to perform the operation on
+  * @param  data: the element, copied when kept
+  * @return 1: the element is kept, possibly evicting the last of the elements kept so far
+  *         0: the element is rejected
+  */
+int topk_push(topk_t* topk, const void* data);
+
+/**
+  * @brief offer count contiguous elements to the accumulator, e.g. a whole vector's data
+  * @param  topk: the accumulator to perform the operation on
+  * @param  data: the first element
+  * @param  count: number of elements
+  * @return number of elements kept at the time they were offered
+  */
+size_t topk_push_n(topk_t* topk, const void* data, size_t count);
+
+/**
+  * @brief the last of the elements kept: once the accumulator is full, an element must come
+  * strictly before it to be kept. Useful to prune work before even building an element.
+  * @param  topk: the accumulator to perform the operation on
+  * @return pointer to the element, valid until the next push
+  *         NULL: fewer than k elements were pushed, and anything will be kept
+  */
+const void* topk_threshold(const topk_t* topk);
+
+/**
+  * @brief number of elements currently kept, at most k
+  */
+size_t topk_size(const topk_t* topk);
+
+/**
+  * @brief append the kept elements to a vector, in the order defined by comp, and clear the accumulator
+  * @param  topk: the accumulator to perform the operation on
+  * @param  out: a vector of the same size_type
+  * @return 0: success
+  *         -1: failure. The accumulator still holds its elements, and out may hold some of them
+  */
+int topk_extract(topk_t* topk, vector_t* out);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
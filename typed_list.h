@@ -0,0 +1,250 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file typed_list.h
+@author Tony Pottier
+@brief Header-only, type-generic doubly linked list generated by macros
+
+DECLARE_LIST(T) generates list_T_t, a doubly linked list whose nodes hold a T
+directly, along with static inline list_T_* functions mirroring list.h.
+DECLARE_LIST_SORT(T, name, comp) generates list_T_name, the bottom-up merge
+sort of list.c with comp called directly: int comp(const T*, const T*).
+
+As with typed_vector.h, T must be a single identifier.
+
+@code{c}
+DECLARE_LIST(vector2f)
+DECLARE_LIST_SORT(vector2f, sort, vector2f_compare)
+
+list_vector2f_t list;
+list_vector2f_create(&list);
+list_vector2f_push_back(&list, v);
+list_vector2f_sort(&list);
+for (list_vector2f_node_t* node = list.begin; node != NULL; node = node->next) {
+    printf("%f %f\n", node->data.x, node->data.y);
+}
+list_vector2f_destroy(&list);
+@endcode
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _TYPED_LIST_H_
+#define _TYPED_LIST_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TYPED_LIST_SORT_NUMLISTS 32
+
+
+#define DECLARE_LIST(T) \
+\
+typedef struct list_##T##_node_t { \
+	struct list_##T##_node_t* previous; \
+	struct list_##T##_node_t* next; \
+	T data; \
+}list_##T##_node_t; \
+\
+typedef struct list_##T##_t { \
+	int size; \
+	list_##T##_node_t* begin; \
+	list_##T##_node_t* end; \
+}list_##T##_t; \
+\
+static inline int list_##T##_create(list_##T##_t* list) \
+{ \
+	if (!list) return -1; \
+	list->size = 0; \
+	list->begin = NULL; \
+	list->end = NULL; \
+	return 0; \
+} \
+\
+static inline void list_##T##_clear(list_##T##_t* list) \
+{ \
+	list_##T##_node_t* next; \
+	list_##T##_node_t* node = list->begin; \
+	while (node != NULL) { \
+		next = node->next; \
+		free(node); \
+		node = next; \
+	} \
+	list->size = 0; \
+	list->begin = NULL; \
+	list->end = NULL; \
+} \
+\
+static inline void list_##T##_destroy(list_##T##_t* list) \
+{ \
+	list_##T##_clear(list); \
+	memset(list, 0x00, sizeof(list_##T##_t)); \
+} \
+\
+static inline list_##T##_node_t* list_##T##_push_back(list_##T##_t* list, T value) \
+{ \
+	list_##T##_node_t* node = (list_##T##_node_t*)malloc(sizeof(list_##T##_node_t)); \
+	if (!node) return NULL; \
+	node->data = value; \
+	node->next = NULL; \
+	node->previous = list->end; \
+	if (list->end) { \
+		list->end->next = node; \
+	} \
+	else { \
+		list->begin = node; \
+	} \
+	list->end = node; \
+	list->size++; \
+	return node; \
+} \
+\
+static inline list_##T##_node_t* list_##T##_push_front(list_##T##_t* list, T value) \
+{ \
+	list_##T##_node_t* node = (list_##T##_node_t*)malloc(sizeof(list_##T##_node_t)); \
+	if (!node) return NULL; \
+	node->data = value; \
+	node->previous = NULL; \
+	node->next = list->begin; \
+	if (list->begin) { \
+		list->begin->previous = node; \
+	} \
+	else { \
+		list->end = node; \
+	} \
+	list->begin = node; \
+	list->size++; \
+	return node; \
+} \
+\
+static inline int list_##T##_pop_front(list_##T##_t* list, T* value) \
+{ \
+	list_##T##_node_t* first = list->begin; \
+	if (!first) return -1; \
+	if (value) *value = first->data; \
+	list->begin = first->next; \
+	if (list->begin) { \
+		list->begin->previous = NULL; \
+	} \
+	else { \
+		list->end = NULL; \
+	} \
+	free(first); \
+	list->size--; \
+	return 0; \
+} \
+\
+static inline int list_##T##_pop_back(list_##T##_t* list, T* value) \
+{ \
+	list_##T##_node_t* last = list->end; \
+	if (!last) return -1; \
+	if (value) *value = last->data; \
+	list->end = last->previous; \
+	if (list->end) { \
+		list->end->next = NULL; \
+	} \
+	else { \
+		list->begin = NULL; \
+	} \
+	free(last); \
+	list->size--; \
+	return 0; \
+} \
+\
+static inline T* list_##T##_front(list_##T##_t* list) \
+{ \
+	return list->begin ? &list->begin->data : NULL; \
+} \
+\
+static inline T* list_##T##_back(list_##T##_t* list) \
+{ \
+	return list->end ? &list->end->data : NULL; \
+}
+
+
+#define DECLARE_LIST_SORT(T, name, comp) \
+\
+static inline list_##T##_node_t* list_##T##_##name##_merge(list_##T##_node_t* list1, list_##T##_node_t* list2) \
+{ \
+	list_##T##_node_t* head = NULL; \
+	list_##T##_node_t** p_head = &head; \
+	if (list1 == NULL) return list2; \
+	if (list2 == NULL) return list1; \
+	for (;;) { \
+		if (comp(&list2->data, &list1->data) < 0) { \
+			*p_head = list2; \
+			list2 = *(p_head = &(list2->next)); \
+			if (list2 == NULL) { \
+				*p_head = list1; \
+				break; \
+			} \
+		} \
+		else { \
+			*p_head = list1; \
+			list1 = *(p_head = &(list1->next)); \
+			if (list1 == NULL) { \
+				*p_head = list2; \
+				break; \
+			} \
+		} \
+	} \
+	return head; \
+} \
+\
+static inline int list_##T##_##name(list_##T##_t* list) \
+{ \
+	list_##T##_node_t* lists[TYPED_LIST_SORT_NUMLISTS]; \
+	list_##T##_node_t* node; \
+	list_##T##_node_t* next; \
+	int i; \
+	if (list->begin == NULL) return 0; \
+	memset(lists, 0, sizeof(lists)); \
+	node = list->begin; \
+	while (node != NULL) { \
+		next = node->next; \
+		node->next = NULL; \
+		for (i = 0; (i < TYPED_LIST_SORT_NUMLISTS) && (lists[i] != NULL); i++) { \
+			node = list_##T##_##name##_merge(lists[i], node); \
+			lists[i] = NULL; \
+		} \
+		if (i == TYPED_LIST_SORT_NUMLISTS) i--; \
+		lists[i] = node; \
+		node = next; \
+	} \
+	node = NULL; \
+	for (i = 0; i < TYPED_LIST_SORT_NUMLISTS; i++) { \
+		node = list_##T##_##name##_merge(lists[i], node); \
+	} \
+	/* restore previous links and list's last element */ \
+	list->begin = node; \
+	node->previous = NULL; \
+	while (node->next != NULL) { \
+		node->next->previous = node; \
+		node = node->next; \
+	} \
+	list->end = node; \
+	return 0; \
+}
+
+#endif
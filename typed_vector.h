@@ -0,0 +1,267 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+@file typed_vector.h
+@author Tony Pottier
+@brief Header-only, type-generic vector generated by macros
+
+vector.h stores elements of a runtime size_type and moves them around with
+memcpy. When the element type is known at compile time, DECLARE_VECTOR(T)
+generates a vector dedicated to T instead: elements are plain assignments,
+every function is static inline and the compiler is free to inline and
+vectorize them.
+
+DECLARE_VECTOR(int) generates the vector_int_t type and the vector_int_*
+functions. T must be a single identifier: use a typedef for types such as
+"unsigned int" or "struct foo".
+
+DECLARE_VECTOR_SORT(T, name, comp) generates vector_T_name, an introsort
+calling comp directly so that it can be inlined too. comp has the usual
+comparator semantics but takes typed pointers: int comp(const T*, const T*).
+
+@code{c}
+static inline int int_compare(const int* a, const int* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+DECLARE_VECTOR(int)
+DECLARE_VECTOR_SORT(int, sort, int_compare)
+
+vector_int_t vector;
+vector_int_create(&vector);
+vector_int_push_back(&vector, 42);
+vector_int_sort(&vector);
+vector_int_destroy(&vector);
+@endcode
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _TYPED_VECTOR_H_
+#define _TYPED_VECTOR_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vector.h"
+
+/* partitions smaller than this are finished with an insertion sort */
+#define TYPED_VECTOR_SORT_THRESHOLD 16
+
+
+#define DECLARE_VECTOR(T) \
+\
+typedef struct vector_##T##_t { \
+	size_t size; \
+	size_t capacity; \
+	T* data; \
+}vector_##T##_t; \
+\
+static inline int vector_##T##_resize(vector_##T##_t* vector, size_t new_capacity) \
+{ \
+	T* new_data = (T*)realloc(vector->data, new_capacity * sizeof(T)); \
+	if (!new_data) return -1; \
+	vector->data = new_data; \
+	vector->capacity = new_capacity; \
+	return 0; \
+} \
+\
+static inline int vector_##T##_create_with(vector_##T##_t* vector, size_t capacity) \
+{ \
+	if (!vector) return -1; \
+	if (capacity == 0) capacity = VECTOR_DEFAULT_INITIAL_SIZE; \
+	vector->size = 0; \
+	vector->capacity = capacity; \
+	vector->data = (T*)malloc(capacity * sizeof(T)); \
+	return vector->data ? 0 : -1; \
+} \
+\
+static inline int vector_##T##_create(vector_##T##_t* vector) \
+{ \
+	return vector_##T##_create_with(vector, VECTOR_DEFAULT_INITIAL_SIZE); \
+} \
+\
+static inline void vector_##T##_destroy(vector_##T##_t* vector) \
+{ \
+	free(vector->data); \
+	memset(vector, 0x00, sizeof(vector_##T##_t)); \
+} \
+\
+static inline void vector_##T##_shrink_check(vector_##T##_t* vector) \
+{ \
+	size_t new_capacity = vector->capacity >> 2; \
+	if (vector->size <= new_capacity && new_capacity >= VECTOR_MINIMUM_CAPACITY) { \
+		vector_##T##_resize(vector, new_capacity); \
+	} \
+} \
+\
+static inline void vector_##T##_clear(vector_##T##_t* vector) \
+{ \
+	vector->size = 0; \
+	vector_##T##_shrink_check(vector); \
+} \
+\
+static inline int vector_##T##_reserve(vector_##T##_t* vector, size_t capacity) \
+{ \
+	if (capacity <= vector->capacity) return 0; \
+	return vector_##T##_resize(vector, capacity); \
+} \
+\
+static inline int vector_##T##_shrink_to_fit(vector_##T##_t* vector) \
+{ \
+	if (vector->size == 0 || vector->size == vector->capacity) return -1; \
+	return vector_##T##_resize(vector, vector->size); \
+} \
+\
+static inline int vector_##T##_push_back(vector_##T##_t* vector, T value) \
+{ \
+	if (vector->size >= vector->capacity) { \
+		if (vector_##T##_resize(vector, vector->capacity << 1) != 0) return -1; \
+	} \
+	vector->data[vector->size++] = value; \
+	return 0; \
+} \
+\
+static inline int vector_##T##_pop_back(vector_##T##_t* vector, T* value) \
+{ \
+	if (vector->size == 0) return -1; \
+	vector->size--; \
+	if (value) *value = vector->data[vector->size]; \
+	vector_##T##_shrink_check(vector); \
+	return 0; \
+} \
+\
+static inline T* vector_##T##_at(vector_##T##_t* vector, size_t n) \
+{ \
+	return vector->data + n; \
+} \
+\
+static inline T* vector_##T##_front(vector_##T##_t* vector) \
+{ \
+	return vector->size ? vector->data : NULL; \
+} \
+\
+static inline T* vector_##T##_back(vector_##T##_t* vector) \
+{ \
+	return vector->size ? vector->data + vector->size - 1 : NULL; \
+} \
+\
+static inline int vector_##T##_qsort(vector_##T##_t* vector, int (*comp)(const void*, const void*)) \
+{ \
+	qsort(vector->data, vector->size, sizeof(T), comp); \
+	return 0; \
+}
+
+
+#define DECLARE_VECTOR_SORT(T, name, comp) \
+\
+static inline void vector_##T##_##name##_insertion_sort(T* a, size_t n) \
+{ \
+	size_t i, j; \
+	T tmp; \
+	for (i = 1; i < n; i++) { \
+		tmp = a[i]; \
+		for (j = i; j > 0 && comp(&tmp, &a[j - 1]) < 0; j--) { \
+			a[j] = a[j - 1]; \
+		} \
+		a[j] = tmp; \
+	} \
+} \
+\
+static inline void vector_##T##_##name##_sift_down(T* a, size_t root, size_t n) \
+{ \
+	size_t child; \
+	T tmp = a[root]; \
+	while ((child = (root << 1) + 1) < n) { \
+		if (child + 1 < n && comp(&a[child], &a[child + 1]) < 0) child++; \
+		if (comp(&tmp, &a[child]) >= 0) break; \
+		a[root] = a[child]; \
+		root = child; \
+	} \
+	a[root] = tmp; \
+} \
+\
+static inline void vector_##T##_##name##_heap_sort(T* a, size_t n) \
+{ \
+	size_t i; \
+	T tmp; \
+	for (i = n >> 1; i > 0; i--) { \
+		vector_##T##_##name##_sift_down(a, i - 1, n); \
+	} \
+	for (i = n - 1; i > 0; i--) { \
+		tmp = a[0]; a[0] = a[i]; a[i] = tmp; \
+		vector_##T##_##name##_sift_down(a, 0, i); \
+	} \
+} \
+\
+static inline void vector_##T##_##name##_introsort(T* a, size_t n, int depth) \
+{ \
+	size_t i, j, mid; \
+	T pivot, tmp; \
+	while (n > TYPED_VECTOR_SORT_THRESHOLD) { \
+		if (depth-- == 0) { \
+			/* quick sort is degenerating: fall back to a guaranteed O(nlogn) */ \
+			vector_##T##_##name##_heap_sort(a, n); \
+			return; \
+		} \
+		/* median of three, which also leaves sentinels at both ends */ \
+		mid = n >> 1; \
+		if (comp(&a[mid], &a[0]) < 0) { tmp = a[mid]; a[mid] = a[0]; a[0] = tmp; } \
+		if (comp(&a[n - 1], &a[0]) < 0) { tmp = a[n - 1]; a[n - 1] = a[0]; a[0] = tmp; } \
+		if (comp(&a[n - 1], &a[mid]) < 0) { tmp = a[n - 1]; a[n - 1] = a[mid]; a[mid] = tmp; } \
+		pivot = a[mid]; \
+		i = 0; \
+		j = n - 1; \
+		for (;;) { \
+			while (comp(&a[i], &pivot) < 0) i++; \
+			while (comp(&pivot, &a[j]) < 0) j--; \
+			if (i >= j) break; \
+			tmp = a[i]; a[i] = a[j]; a[j] = tmp; \
+			i++; \
+			j--; \
+		} \
+		/* [0, i) <= pivot <= [j + 1, n): recurse on the smaller side, loop on the larger */ \
+		if (i < n - (j + 1)) { \
+			vector_##T##_##name##_introsort(a, i, depth); \
+			a += j + 1; \
+			n -= j + 1; \
+		} \
+		else { \
+			vector_##T##_##name##_introsort(a + j + 1, n - (j + 1), depth); \
+			n = i; \
+		} \
+	} \
+	vector_##T##_##name##_insertion_sort(a, n); \
+} \
+\
+static inline int vector_##T##_##name(vector_##T##_t* vector) \
+{ \
+	int depth = 0; \
+	size_t n; \
+	for (n = vector->size; n > 1; n >>= 1) depth += 2; \
+	vector_##T##_##name##_introsort(vector->data, vector->size, depth); \
+	return 0; \
+}
+
+#endif
@@ -29,6 +29,14 @@ its capacity before it starts reallocating.
 This behavior should lead to better performance. Memory conscious people
 can use the shrink_to_fit API
 
+Popping the first element does not shift the array: data simply moves one
+slot forward and the freed slot is kept in front of it, as part of the
+head. Pushing to the front reuses the head, or opens a new one as large as
+the vector when there is none. The head is given back to the end of the
+buffer (one memmove) when the vector runs out of room and the head is at
+least as large as the vector itself, so a vector used as a FIFO is O(1)
+amortized at both ends.
+
 @see https://github.com/tonyp7/stdcontainers
 
 */
@@ -38,30 +46,61 @@ can use the shrink_to_fit API
 #include <stdlib.h>
 #include "vector.h"
 
+/**
+ * @brief start of the allocated buffer, head slots before data
+ */
+static inline uint8_t* _vector_base(vector_t* vector)
+{
+	return vector->head ? vector->data - vector->head * vector->size_type : vector->data;
+}
+
+/**
+ * @brief give the head back to the end of the buffer: data is moved to the start of the allocation
+ */
+static inline void _vector_compact(vector_t* vector)
+{
+	uint8_t* base;
+
+	if (vector->head == 0) return;
+
+	base = _vector_base(vector);
+	memmove(base, vector->data, vector->size * vector->size_type);
+	vector->data = base;
+	vector->capacity += vector->head;
+	vector->head = 0;
+}
+
 static inline int _vector_resize(vector_t* vector, size_t new_capacity)
 {
-	void* new_data = realloc(vector->data, new_capacity * vector->size_type);
+	void* new_base = realloc(_vector_base(vector), (vector->head + new_capacity) * vector->size_type);
 
-	if (new_data) {
-		vector->data = (uint8_t*)new_data;
+	if (new_base) {
+		vector->data = (uint8_t*)new_base + vector->head * vector->size_type;
 		vector->capacity = new_capacity;
+		STDCONTAINERS_STATS_INC(vector, reallocs);
+		STDCONTAINERS_STATS_ADD(vector, bytes_allocated, (vector->head + new_capacity) * vector->size_type);
 	}
-	return new_data != NULL;
+	return new_base != NULL;
 }
 
 
 static inline int _vector_shrink_check(vector_t* vector)
 {
-	return vector->size <= vector->capacity >> 2;
+	return vector->size <= (vector->head + vector->capacity) >> 2;
 }
 
 static inline int _vector_shrink(vector_t* vector)
 {
-	size_t new_capacity = vector->capacity >> 2;
+	size_t new_capacity;
+
+	_vector_compact(vector);
+
+	new_capacity = vector->capacity >> 2;
 	if (new_capacity < VECTOR_MINIMUM_CAPACITY) {
 		new_capacity = VECTOR_MINIMUM_CAPACITY;
 	}
-	return _vector_resize(vector, VECTOR_MINIMUM_CAPACITY);
+	STDCONTAINERS_STATS_INC(vector, shrinks);
+	return _vector_resize(vector, new_capacity);
 }
 
 static inline void* _vector_at(vector_t* vector, int n)
@@ -86,7 +125,92 @@ static inline int _vector_grow_check(vector_t* vector)
 
 static inline int _vector_grow(vector_t* vector)
 {
-	return _vector_resize(vector, vector->capacity << 1);
+	size_t new_capacity;
+
+	if (vector->head) {
+		/* mostly empty slots in front: reusing them is enough, and cheaper than a realloc */
+		if (vector->head >= vector->size) {
+			_vector_compact(vector);
+			return 1;
+		}
+		_vector_compact(vector);
+	}
+
+	/* a vector whose buffer was handed over elsewhere has no capacity left to double */
+	new_capacity = vector->capacity ? vector->capacity << 1 : VECTOR_DEFAULT_INITIAL_SIZE;
+	STDCONTAINERS_STATS_INC(vector, grows);
+	return _vector_resize(vector, new_capacity);
+}
+
+/**
+ * @brief make sure there is at least one free slot before data
+ */
+static inline int _vector_reserve_head(vector_t* vector)
+{
+	size_t gap, total;
+	uint8_t* base;
+
+	if (vector->head) return 1;
+
+	/* open a head as large as the vector so that the next size pushes to the front are free */
+	gap = vector->size > VECTOR_MINIMUM_CAPACITY ? vector->size : VECTOR_MINIMUM_CAPACITY;
+	total = vector->capacity;
+	if (vector->size + gap > total) {
+		STDCONTAINERS_STATS_INC(vector, grows);
+		if (!_vector_resize(vector, vector->size + gap)) {
+			return 0;
+		}
+		total = vector->capacity;
+	}
+
+	base = vector->data;
+	vector->data = base + gap * vector->size_type;
+	memmove(vector->data, base, vector->size * vector->size_type);
+	vector->head = gap;
+	vector->capacity = total - gap;
+
+	return 1;
+}
+
+/**
+ * @brief add an uninitialized slot in front of the first element, using the head
+ */
+static inline void* _vector_push_front_slot(vector_t* vector)
+{
+	if (!_vector_reserve_head(vector)) return NULL;
+
+	vector->data -= vector->size_type;
+	vector->head--;
+	vector->capacity++;
+	vector->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(vector);
+
+	return vector->data;
+}
+
+/**
+ * @brief remove the first count elements by moving data forward: their slots join the head
+ */
+static inline void _vector_drop_front(vector_t* vector, size_t count)
+{
+	vector->size -= count;
+
+	if (vector->size == 0) {
+		/* nothing left to move: start over from the beginning of the buffer */
+		vector->data = _vector_base(vector);
+		vector->capacity += vector->head;
+		vector->head = 0;
+	}
+	else {
+		vector->data += count * vector->size_type;
+		vector->head += count;
+		vector->capacity -= count;
+	}
+}
+
+static inline void _vector_pop_front_slot(vector_t* vector)
+{
+	_vector_drop_front(vector, 1);
 }
 
 static inline int _vector_shift_right(vector_t* vector, int n)
@@ -124,6 +248,10 @@ int vector_create_with(vector_t* vector, size_t size_type, size_t capacity)
 	vector->capacity = capacity;
 	vector->size_type = size_type;
 	vector->size = 0;
+	vector->head = 0;
+#ifdef STDCONTAINERS_STATS
+	memset(&vector->stats, 0x00, sizeof(container_stats_t));
+#endif
 
 	vector->data = (uint8_t*)malloc(capacity * size_type);
 
@@ -131,6 +259,9 @@ int vector_create_with(vector_t* vector, size_t size_type, size_t capacity)
 		return -1;
 	}
 
+	STDCONTAINERS_STATS_INC(vector, allocations);
+	STDCONTAINERS_STATS_ADD(vector, bytes_allocated, capacity * size_type);
+
 	return 0;
 }
 
@@ -139,6 +270,7 @@ void vector_clear(vector_t* vector)
 {
 	if (vector->size) {
 		vector->size = 0;
+		_vector_compact(vector);
 
 		if (_vector_shrink_check(vector)) {
 			_vector_shrink(vector);
@@ -150,7 +282,8 @@ void vector_clear(vector_t* vector)
 void vector_destroy(vector_t* vector)
 {
     if(vector && vector->data){
-        free(vector->data);
+        free(_vector_base(vector));
+        STDCONTAINERS_STATS_INC(vector, frees);
     }
     
     memset(vector, 0x00, sizeof(vector_t));
@@ -164,7 +297,690 @@ void* vector_at(vector_t* vector, int n)
 
 int vector_sort(vector_t* vector, int (*comp)(const void*, const void*))
 {
-	qsort(vector->data, vector->size, vector->size_type, comp);
+	qsort(vector->data, vector->size, vector->size_type, STDCONTAINERS_STATS_COMPARATOR(vector, comp));
+	return 0;
+}
+
+
+/* natural merge sort (TimSort) behind vector_stable_sort. Indices are signed: merge_hi
+walks its cursors down to one before the start of a run */
+typedef struct _vector_sort_t {
+	uint8_t* a;
+	size_t size_type;
+	int (*comp)(const void*, const void*);
+	vector_t* scratch;
+	uint8_t* pivot;
+	uint8_t* tmp;
+	ptrdiff_t min_gallop;
+	int runs;
+	ptrdiff_t run_base[VECTOR_STABLE_SORT_MAX_RUNS];
+	ptrdiff_t run_len[VECTOR_STABLE_SORT_MAX_RUNS];
+}_vector_sort_t;
+
+#define _SORT_AT(p, i) ((p) + (i) * (ptrdiff_t)sort->size_type)
+
+static inline void _vector_sort_copy(_vector_sort_t* sort, uint8_t* dst, const uint8_t* src, ptrdiff_t n)
+{
+	memmove(dst, src, (size_t)n * sort->size_type);
+}
+
+/**
+ * @brief make room for n elements in the merge buffer, plus the pivot slot
+ */
+static int _vector_sort_reserve(_vector_sort_t* sort, ptrdiff_t n)
+{
+	vector_t* scratch = sort->scratch;
+
+	if (scratch->capacity < (size_t)n + 1) {
+		size_t capacity = scratch->capacity ? scratch->capacity : VECTOR_DEFAULT_INITIAL_SIZE;
+		while (capacity < (size_t)n + 1) {
+			capacity <<= 1;
+		}
+		if (!_vector_resize(scratch, capacity)) return -1;
+	}
+
+	sort->pivot = scratch->data;
+	sort->tmp = scratch->data + sort->size_type;
+
+	return 0;
+}
+
+static ptrdiff_t _vector_sort_gallop_left(_vector_sort_t* sort, const uint8_t* key, uint8_t* a, ptrdiff_t len, ptrdiff_t hint)
+{
+	ptrdiff_t last_ofs = 0, ofs = 1, max_ofs, tmp, m;
+
+	if (sort->comp(key, _SORT_AT(a, hint)) > 0) {
+		/* gallop right until a[hint + last_ofs] < key <= a[hint + ofs] */
+		max_ofs = len - hint;
+		while (ofs < max_ofs && sort->comp(key, _SORT_AT(a, hint + ofs)) > 0) {
+			last_ofs = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		if (ofs > max_ofs) ofs = max_ofs;
+		last_ofs += hint;
+		ofs += hint;
+	}
+	else {
+		/* gallop left until a[hint - ofs] < key <= a[hint - last_ofs] */
+		max_ofs = hint + 1;
+		while (ofs < max_ofs && sort->comp(key, _SORT_AT(a, hint - ofs)) <= 0) {
+			last_ofs = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		if (ofs > max_ofs) ofs = max_ofs;
+		tmp = last_ofs;
+		last_ofs = hint - ofs;
+		ofs = hint - tmp;
+	}
+
+	/* a[last_ofs] < key <= a[ofs]: binary search in between */
+	last_ofs++;
+	while (last_ofs < ofs) {
+		m = last_ofs + ((ofs - last_ofs) >> 1);
+		if (sort->comp(key, _SORT_AT(a, m)) > 0) {
+			last_ofs = m + 1;
+		}
+		else {
+			ofs = m;
+		}
+	}
+
+	return ofs;
+}
+
+static ptrdiff_t _vector_sort_gallop_right(_vector_sort_t* sort, const uint8_t* key, uint8_t* a, ptrdiff_t len, ptrdiff_t hint)
+{
+	ptrdiff_t last_ofs = 0, ofs = 1, max_ofs, tmp, m;
+
+	if (sort->comp(key, _SORT_AT(a, hint)) < 0) {
+		/* gallop left until a[hint - ofs] <= key < a[hint - last_ofs] */
+		max_ofs = hint + 1;
+		while (ofs < max_ofs && sort->comp(key, _SORT_AT(a, hint - ofs)) < 0) {
+			last_ofs = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		if (ofs > max_ofs) ofs = max_ofs;
+		tmp = last_ofs;
+		last_ofs = hint - ofs;
+		ofs = hint - tmp;
+	}
+	else {
+		/* gallop right until a[hint + last_ofs] <= key < a[hint + ofs] */
+		max_ofs = len - hint;
+		while (ofs < max_ofs && sort->comp(key, _SORT_AT(a, hint + ofs)) >= 0) {
+			last_ofs = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		if (ofs > max_ofs) ofs = max_ofs;
+		last_ofs += hint;
+		ofs += hint;
+	}
+
+	last_ofs++;
+	while (last_ofs < ofs) {
+		m = last_ofs + ((ofs - last_ofs) >> 1);
+		if (sort->comp(key, _SORT_AT(a, m)) < 0) {
+			ofs = m;
+		}
+		else {
+			last_ofs = m + 1;
+		}
+	}
+
+	return ofs;
+}
+
+/**
+ * @brief length of the run starting at lo. A strictly descending run is reversed in place
+ */
+static ptrdiff_t _vector_sort_count_run(_vector_sort_t* sort, ptrdiff_t lo, ptrdiff_t hi)
+{
+	ptrdiff_t run_hi = lo + 1;
+	uint8_t* left;
+	uint8_t* right;
+
+	if (run_hi == hi) return 1;
+
+	if (sort->comp(_SORT_AT(sort->a, run_hi), _SORT_AT(sort->a, lo)) < 0) {
+		run_hi++;
+		while (run_hi < hi && sort->comp(_SORT_AT(sort->a, run_hi), _SORT_AT(sort->a, run_hi - 1)) < 0) {
+			run_hi++;
+		}
+		/* strictly descending only, so that reversing keeps equal elements in order */
+		left = _SORT_AT(sort->a, lo);
+		right = _SORT_AT(sort->a, run_hi - 1);
+		while (left < right) {
+			memcpy(sort->pivot, left, sort->size_type);
+			memcpy(left, right, sort->size_type);
+			memcpy(right, sort->pivot, sort->size_type);
+			left += sort->size_type;
+			right -= sort->size_type;
+		}
+	}
+	else {
+		run_hi++;
+		while (run_hi < hi && sort->comp(_SORT_AT(sort->a, run_hi), _SORT_AT(sort->a, run_hi - 1)) >= 0) {
+			run_hi++;
+		}
+	}
+
+	return run_hi - lo;
+}
+
+/**
+ * @brief binary insertion sort of [lo, hi), knowing that [lo, start) is already sorted
+ */
+static void _vector_sort_binary_insertion(_vector_sort_t* sort, ptrdiff_t lo, ptrdiff_t hi, ptrdiff_t start)
+{
+	ptrdiff_t left, right, mid;
+
+	if (start == lo) start++;
+
+	for (; start < hi; start++) {
+		memcpy(sort->pivot, _SORT_AT(sort->a, start), sort->size_type);
+
+		left = lo;
+		right = start;
+		while (left < right) {
+			mid = left + ((right - left) >> 1);
+			if (sort->comp(sort->pivot, _SORT_AT(sort->a, mid)) < 0) {
+				right = mid;
+			}
+			else {
+				left = mid + 1;
+			}
+		}
+
+		_vector_sort_copy(sort, _SORT_AT(sort->a, left + 1), _SORT_AT(sort->a, left), start - left);
+		memcpy(_SORT_AT(sort->a, left), sort->pivot, sort->size_type);
+	}
+}
+
+/**
+ * @brief merge two adjacent runs when the first one is the shortest: it is moved to the
+ * scratch buffer and the merge goes left to right
+ */
+static int _vector_sort_merge_lo(_vector_sort_t* sort, ptrdiff_t base1, ptrdiff_t len1, ptrdiff_t base2, ptrdiff_t len2)
+{
+	uint8_t* a = sort->a;
+	uint8_t* tmp;
+	ptrdiff_t cursor1 = 0, cursor2 = base2, dest = base1;
+	ptrdiff_t count1, count2, min_gallop;
+
+	if (_vector_sort_reserve(sort, len1) != 0) return -1;
+	tmp = sort->tmp;
+	_vector_sort_copy(sort, tmp, _SORT_AT(a, base1), len1);
+
+	memcpy(_SORT_AT(a, dest++), _SORT_AT(a, cursor2++), sort->size_type);
+	if (--len2 == 0) {
+		_vector_sort_copy(sort, _SORT_AT(a, dest), _SORT_AT(tmp, cursor1), len1);
+		return 0;
+	}
+	if (len1 == 1) {
+		_vector_sort_copy(sort, _SORT_AT(a, dest), _SORT_AT(a, cursor2), len2);
+		memcpy(_SORT_AT(a, dest + len2), _SORT_AT(tmp, cursor1), sort->size_type);
+		return 0;
+	}
+
+	min_gallop = sort->min_gallop;
+	for (;;) {
+		count1 = 0;
+		count2 = 0;
+
+		/* one element at a time until a run starts winning consistently */
+		do {
+			if (sort->comp(_SORT_AT(a, cursor2), _SORT_AT(tmp, cursor1)) < 0) {
+				memcpy(_SORT_AT(a, dest++), _SORT_AT(a, cursor2++), sort->size_type);
+				count2++;
+				count1 = 0;
+				if (--len2 == 0) goto done;
+			}
+			else {
+				memcpy(_SORT_AT(a, dest++), _SORT_AT(tmp, cursor1++), sort->size_type);
+				count1++;
+				count2 = 0;
+				if (--len1 == 1) goto done;
+			}
+		} while ((count1 | count2) < min_gallop);
+
+		/* galloping: find how many elements of a run go in a row and move them at once */
+		do {
+			count1 = _vector_sort_gallop_right(sort, _SORT_AT(a, cursor2), _SORT_AT(tmp, cursor1), len1, 0);
+			if (count1 != 0) {
+				_vector_sort_copy(sort, _SORT_AT(a, dest), _SORT_AT(tmp, cursor1), count1);
+				dest += count1;
+				cursor1 += count1;
+				len1 -= count1;
+				if (len1 <= 1) goto done;
+			}
+			memcpy(_SORT_AT(a, dest++), _SORT_AT(a, cursor2++), sort->size_type);
+			if (--len2 == 0) goto done;
+
+			count2 = _vector_sort_gallop_left(sort, _SORT_AT(tmp, cursor1), _SORT_AT(a, cursor2), len2, 0);
+			if (count2 != 0) {
+				_vector_sort_copy(sort, _SORT_AT(a, dest), _SORT_AT(a, cursor2), count2);
+				dest += count2;
+				cursor2 += count2;
+				len2 -= count2;
+				if (len2 == 0) goto done;
+			}
+			memcpy(_SORT_AT(a, dest++), _SORT_AT(tmp, cursor1++), sort->size_type);
+			if (--len1 == 1) goto done;
+			min_gallop--;
+		} while (count1 >= VECTOR_STABLE_SORT_MIN_GALLOP || count2 >= VECTOR_STABLE_SORT_MIN_GALLOP);
+
+		if (min_gallop < 0) min_gallop = 0;
+		min_gallop += 2;
+	}
+
+done:
+	sort->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+	if (len1 == 1) {
+		_vector_sort_copy(sort, _SORT_AT(a, dest), _SORT_AT(a, cursor2), len2);
+		memcpy(_SORT_AT(a, dest + len2), _SORT_AT(tmp, cursor1), sort->size_type);
+	}
+	else if (len1 > 1) {
+		_vector_sort_copy(sort, _SORT_AT(a, dest), _SORT_AT(tmp, cursor1), len1);
+	}
+	/* len1 == 0 only happens with an inconsistent comparator: nothing is lost, order is undefined */
+
+	return 0;
+}
+
+/**
+ * @brief merge two adjacent runs when the second one is the shortest: it is moved to the
+ * scratch buffer and the merge goes right to left
+ */
+static int _vector_sort_merge_hi(_vector_sort_t* sort, ptrdiff_t base1, ptrdiff_t len1, ptrdiff_t base2, ptrdiff_t len2)
+{
+	uint8_t* a = sort->a;
+	uint8_t* tmp;
+	ptrdiff_t cursor1, cursor2, dest;
+	ptrdiff_t count1, count2, min_gallop;
+
+	if (_vector_sort_reserve(sort, len2) != 0) return -1;
+	tmp = sort->tmp;
+	_vector_sort_copy(sort, tmp, _SORT_AT(a, base2), len2);
+
+	cursor1 = base1 + len1 - 1;
+	cursor2 = len2 - 1;
+	dest = base2 + len2 - 1;
+
+	memcpy(_SORT_AT(a, dest--), _SORT_AT(a, cursor1--), sort->size_type);
+	if (--len1 == 0) {
+		_vector_sort_copy(sort, _SORT_AT(a, dest - (len2 - 1)), tmp, len2);
+		return 0;
+	}
+	if (len2 == 1) {
+		dest -= len1;
+		cursor1 -= len1;
+		_vector_sort_copy(sort, _SORT_AT(a, dest + 1), _SORT_AT(a, cursor1 + 1), len1);
+		memcpy(_SORT_AT(a, dest), _SORT_AT(tmp, cursor2), sort->size_type);
+		return 0;
+	}
+
+	min_gallop = sort->min_gallop;
+	for (;;) {
+		count1 = 0;
+		count2 = 0;
+
+		do {
+			if (sort->comp(_SORT_AT(tmp, cursor2), _SORT_AT(a, cursor1)) < 0) {
+				memcpy(_SORT_AT(a, dest--), _SORT_AT(a, cursor1--), sort->size_type);
+				count1++;
+				count2 = 0;
+				if (--len1 == 0) goto done;
+			}
+			else {
+				memcpy(_SORT_AT(a, dest--), _SORT_AT(tmp, cursor2--), sort->size_type);
+				count2++;
+				count1 = 0;
+				if (--len2 == 1) goto done;
+			}
+		} while ((count1 | count2) < min_gallop);
+
+		do {
+			count1 = len1 - _vector_sort_gallop_right(sort, _SORT_AT(tmp, cursor2), _SORT_AT(a, base1), len1, len1 - 1);
+			if (count1 != 0) {
+				dest -= count1;
+				cursor1 -= count1;
+				len1 -= count1;
+				_vector_sort_copy(sort, _SORT_AT(a, dest + 1), _SORT_AT(a, cursor1 + 1), count1);
+				if (len1 == 0) goto done;
+			}
+			memcpy(_SORT_AT(a, dest--), _SORT_AT(tmp, cursor2--), sort->size_type);
+			if (--len2 == 1) goto done;
+
+			count2 = len2 - _vector_sort_gallop_left(sort, _SORT_AT(a, cursor1), tmp, len2, len2 - 1);
+			if (count2 != 0) {
+				dest -= count2;
+				cursor2 -= count2;
+				len2 -= count2;
+				_vector_sort_copy(sort, _SORT_AT(a, dest + 1), _SORT_AT(tmp, cursor2 + 1), count2);
+				if (len2 <= 1) goto done;
+			}
+			memcpy(_SORT_AT(a, dest--), _SORT_AT(a, cursor1--), sort->size_type);
+			if (--len1 == 0) goto done;
+			min_gallop--;
+		} while (count1 >= VECTOR_STABLE_SORT_MIN_GALLOP || count2 >= VECTOR_STABLE_SORT_MIN_GALLOP);
+
+		if (min_gallop < 0) min_gallop = 0;
+		min_gallop += 2;
+	}
+
+done:
+	sort->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+	if (len2 == 1) {
+		dest -= len1;
+		cursor1 -= len1;
+		_vector_sort_copy(sort, _SORT_AT(a, dest + 1), _SORT_AT(a, cursor1 + 1), len1);
+		memcpy(_SORT_AT(a, dest), _SORT_AT(tmp, cursor2), sort->size_type);
+	}
+	else if (len2 > 1) {
+		_vector_sort_copy(sort, _SORT_AT(a, dest - (len2 - 1)), tmp, len2);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief merge the runs i and i + 1 of the stack
+ */
+static int _vector_sort_merge_at(_vector_sort_t* sort, int i)
+{
+	ptrdiff_t base1 = sort->run_base[i];
+	ptrdiff_t len1 = sort->run_len[i];
+	ptrdiff_t base2 = sort->run_base[i + 1];
+	ptrdiff_t len2 = sort->run_len[i + 1];
+	ptrdiff_t k;
+
+	sort->run_len[i] = len1 + len2;
+	if (i == sort->runs - 3) {
+		sort->run_base[i + 1] = sort->run_base[i + 2];
+		sort->run_len[i + 1] = sort->run_len[i + 2];
+	}
+	sort->runs--;
+
+	/* elements of run 1 smaller than run 2's first element, and elements of run 2
+	larger than run 1's last element, are already in place */
+	k = _vector_sort_gallop_right(sort, _SORT_AT(sort->a, base2), _SORT_AT(sort->a, base1), len1, 0);
+	base1 += k;
+	len1 -= k;
+	if (len1 == 0) return 0;
+
+	len2 = _vector_sort_gallop_left(sort, _SORT_AT(sort->a, base1 + len1 - 1), _SORT_AT(sort->a, base2), len2, len2 - 1);
+	if (len2 == 0) return 0;
+
+	if (len1 <= len2) {
+		return _vector_sort_merge_lo(sort, base1, len1, base2, len2);
+	}
+	else {
+		return _vector_sort_merge_hi(sort, base1, len1, base2, len2);
+	}
+}
+
+/**
+ * @brief merge runs until the stack lengths grow at least like the Fibonacci sequence
+ */
+static int _vector_sort_merge_collapse(_vector_sort_t* sort)
+{
+	ptrdiff_t* len = sort->run_len;
+	int n;
+
+	while (sort->runs > 1) {
+		n = sort->runs - 2;
+		if ((n > 0 && len[n - 1] <= len[n] + len[n + 1]) || (n > 1 && len[n - 2] <= len[n - 1] + len[n])) {
+			if (len[n - 1] < len[n + 1]) n--;
+		}
+		else if (len[n] > len[n + 1]) {
+			break;
+		}
+		if (_vector_sort_merge_at(sort, n) != 0) return -1;
+	}
+
+	return 0;
+}
+
+static int _vector_sort_merge_force_collapse(_vector_sort_t* sort)
+{
+	int n;
+
+	while (sort->runs > 1) {
+		n = sort->runs - 2;
+		if (n > 0 && sort->run_len[n - 1] < sort->run_len[n + 1]) n--;
+		if (_vector_sort_merge_at(sort, n) != 0) return -1;
+	}
+
+	return 0;
+}
+
+static ptrdiff_t _vector_sort_min_run(ptrdiff_t n)
+{
+	ptrdiff_t r = 0;
+
+	while (n >= VECTOR_STABLE_SORT_MIN_MERGE) {
+		r |= n & 1;
+		n >>= 1;
+	}
+
+	return n + r;
+}
+
+int vector_stable_sort_with(vector_t* vector, int (*comp)(const void*, const void*), vector_t* scratch)
+{
+	_vector_sort_t sort;
+	ptrdiff_t lo = 0;
+	ptrdiff_t remaining = (ptrdiff_t)vector->size;
+	ptrdiff_t min_run, run_len, force;
+
+	if (!comp || !scratch || scratch == vector || scratch->size_type != vector->size_type) return -1;
+	if (remaining < 2) return 0;
+
+	/* the scratch vector only lends its buffer */
+	scratch->size = 0;
+	_vector_compact(scratch);
+
+	sort.a = vector->data;
+	sort.size_type = vector->size_type;
+	sort.comp = STDCONTAINERS_STATS_COMPARATOR(vector, comp);
+	sort.scratch = scratch;
+	sort.min_gallop = VECTOR_STABLE_SORT_MIN_GALLOP;
+	sort.runs = 0;
+
+	if (_vector_sort_reserve(&sort, 0) != 0) return -1;
+
+	if (remaining < VECTOR_STABLE_SORT_MIN_MERGE) {
+		run_len = _vector_sort_count_run(&sort, 0, remaining);
+		_vector_sort_binary_insertion(&sort, 0, remaining, run_len);
+		return 0;
+	}
+
+	min_run = _vector_sort_min_run(remaining);
+	do {
+		/* natural run, extended to min_run elements when shorter */
+		run_len = _vector_sort_count_run(&sort, lo, lo + remaining);
+		if (run_len < min_run) {
+			force = remaining <= min_run ? remaining : min_run;
+			_vector_sort_binary_insertion(&sort, lo, lo + force, lo + run_len);
+			run_len = force;
+		}
+
+		sort.run_base[sort.runs] = lo;
+		sort.run_len[sort.runs] = run_len;
+		sort.runs++;
+		if (_vector_sort_merge_collapse(&sort) != 0) return -1;
+
+		lo += run_len;
+		remaining -= run_len;
+	} while (remaining != 0);
+
+	return _vector_sort_merge_force_collapse(&sort);
+}
+
+int vector_stable_sort(vector_t* vector, int (*comp)(const void*, const void*))
+{
+	vector_t scratch;
+	int ret;
+
+	if (vector_create_with(&scratch, vector->size_type, VECTOR_DEFAULT_INITIAL_SIZE) != 0) return -1;
+
+	ret = vector_stable_sort_with(vector, comp, &scratch);
+
+	vector_destroy(&scratch);
+
+	return ret;
+}
+
+/* selection helpers behind vector_nth_element and vector_partial_sort. Elements are only ever
+swapped, so no buffer is needed whatever the size_type */
+#define _SELECT_AT(a, i) ((a) + (i) * size_type)
+
+static inline void _vector_swap(uint8_t* a, uint8_t* b, size_t size_type)
+{
+	uint8_t tmp[64];
+	size_t chunk;
+
+	while (size_type) {
+		chunk = size_type < sizeof(tmp) ? size_type : sizeof(tmp);
+		memcpy(tmp, a, chunk);
+		memcpy(a, b, chunk);
+		memcpy(b, tmp, chunk);
+		a += chunk;
+		b += chunk;
+		size_type -= chunk;
+	}
+}
+
+/**
+ * @brief restore the max heap property of a[0, n) below root
+ */
+static void _vector_sift_down(uint8_t* a, size_t root, size_t n, size_t size_type, int (*comp)(const void*, const void*))
+{
+	size_t child;
+
+	while ((child = (root << 1) + 1) < n) {
+		if (child + 1 < n && comp(_SELECT_AT(a, child), _SELECT_AT(a, child + 1)) < 0) child++;
+		if (comp(_SELECT_AT(a, root), _SELECT_AT(a, child)) >= 0) break;
+		_vector_swap(_SELECT_AT(a, root), _SELECT_AT(a, child), size_type);
+		root = child;
+	}
+}
+
+/**
+ * @brief gather the k smallest elements of a[0, n) into a max heap at a[0, k)
+ */
+static void _vector_heap_select(uint8_t* a, size_t k, size_t n, size_t size_type, int (*comp)(const void*, const void*))
+{
+	size_t i;
+
+	for (i = k >> 1; i > 0; i--) {
+		_vector_sift_down(a, i - 1, k, size_type, comp);
+	}
+
+	/* a single comparison against the root rejects most of the remaining elements */
+	for (i = k; i < n; i++) {
+		if (comp(_SELECT_AT(a, i), a) < 0) {
+			_vector_swap(a, _SELECT_AT(a, i), size_type);
+			_vector_sift_down(a, 0, k, size_type, comp);
+		}
+	}
+}
+
+static void _vector_sort_heap(uint8_t* a, size_t n, size_t size_type, int (*comp)(const void*, const void*))
+{
+	size_t i;
+
+	for (i = n; i > 1; i--) {
+		_vector_swap(a, _SELECT_AT(a, i - 1), size_type);
+		_vector_sift_down(a, 0, i - 1, size_type, comp);
+	}
+}
+
+static void _vector_insertion_sort(uint8_t* a, size_t n, size_t size_type, int (*comp)(const void*, const void*))
+{
+	size_t i, j;
+
+	for (i = 1; i < n; i++) {
+		for (j = i; j > 0 && comp(_SELECT_AT(a, j), _SELECT_AT(a, j - 1)) < 0; j--) {
+			_vector_swap(_SELECT_AT(a, j), _SELECT_AT(a, j - 1), size_type);
+		}
+	}
+}
+
+static void _vector_select(uint8_t* a, size_t n, size_t nth, size_t size_type, int (*comp)(const void*, const void*))
+{
+	size_t i, j, mid;
+	int depth = 0;
+
+	for (i = n; i > 1; i >>= 1) depth += 2;
+
+	while (n > VECTOR_SELECT_THRESHOLD) {
+		if (depth-- == 0) {
+			/* quick select is degenerating: the root of a heap of the nth + 1 smallest is the nth element */
+			_vector_heap_select(a, nth + 1, n, size_type, comp);
+			_vector_swap(a, _SELECT_AT(a, nth), size_type);
+			return;
+		}
+
+		/* median of three as pivot in a[0], with the largest of the three as sentinel in a[n - 1] */
+		mid = n >> 1;
+		if (comp(_SELECT_AT(a, mid), a) < 0) _vector_swap(_SELECT_AT(a, mid), a, size_type);
+		if (comp(_SELECT_AT(a, n - 1), a) < 0) _vector_swap(_SELECT_AT(a, n - 1), a, size_type);
+		if (comp(_SELECT_AT(a, n - 1), _SELECT_AT(a, mid)) < 0) _vector_swap(_SELECT_AT(a, n - 1), _SELECT_AT(a, mid), size_type);
+		_vector_swap(a, _SELECT_AT(a, mid), size_type);
+
+		/* the pivot stays in a[0] while a[1, n) is partitioned around it */
+		i = 0;
+		j = n;
+		for (;;) {
+			do i++; while (comp(_SELECT_AT(a, i), a) < 0);
+			do j--; while (comp(a, _SELECT_AT(a, j)) < 0);
+			if (i >= j) break;
+			_vector_swap(_SELECT_AT(a, i), _SELECT_AT(a, j), size_type);
+		}
+		_vector_swap(a, _SELECT_AT(a, j), size_type);
+
+		/* [0, j) <= pivot <= (j, n): keep the side holding nth */
+		if (nth == j) return;
+		if (nth < j) {
+			n = j;
+		}
+		else {
+			a = _SELECT_AT(a, j + 1);
+			nth -= j + 1;
+			n -= j + 1;
+		}
+	}
+
+	_vector_insertion_sort(a, n, size_type, comp);
+}
+
+int vector_nth_element(vector_t* vector, int n, int (*comp)(const void*, const void*))
+{
+	if (n < 0 || (size_t)n >= vector->size) return -1;
+
+	_vector_select(vector->data, vector->size, (size_t)n, vector->size_type, STDCONTAINERS_STATS_COMPARATOR(vector, comp));
+
+	return 0;
+}
+
+int vector_partial_sort(vector_t* vector, int k, int (*comp)(const void*, const void*))
+{
+	if (k < 0) return -1;
+	if ((size_t)k >= vector->size) return vector_sort(vector, comp);
+	if (k == 0) return 0;
+
+	comp = STDCONTAINERS_STATS_COMPARATOR(vector, comp);
+
+	if ((size_t)k <= vector->size / VECTOR_PARTIAL_SORT_HEAP_RATIO) {
+		_vector_heap_select(vector->data, (size_t)k, vector->size, vector->size_type, comp);
+		_vector_sort_heap(vector->data, (size_t)k, vector->size_type, comp);
+	}
+	else {
+		_vector_select(vector->data, vector->size, (size_t)k - 1, vector->size_type, comp);
+		qsort(vector->data, (size_t)k - 1, vector->size_type, comp);
+	}
+
 	return 0;
 }
 
@@ -179,17 +995,25 @@ int vector_push_back(vector_t* vector, const void* data)
 	_vector_assign(vector, vector->size, data);
 
 	vector->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(vector);
 
 	return 0;
 }
 
 int vector_push_front(vector_t* vector, const void* data) 
 {
-	return vector_insert(vector, 0, data);
+	void* slot = _vector_push_front_slot(vector);
+	if (!slot) return -1;
+
+	_vector_assign_ptr(vector, slot, data);
+
+	return 0;
 }
 
 int vector_insert(vector_t* vector, int n, const void* data)
 {
+	if (n == 0) return vector_push_front(vector, data);
+
 	if (_vector_grow_check(vector)) {
 		if (!_vector_grow(vector)) {
 			return -1;
@@ -200,10 +1024,45 @@ int vector_insert(vector_t* vector, int n, const void* data)
 	_vector_assign(vector, n, data);
 
 	vector->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(vector);
 
 	return 0;
 }
 
+void* vector_emplace_back(vector_t* vector)
+{
+	if (_vector_grow_check(vector)) {
+		if (!_vector_grow(vector)) {
+			return NULL;
+		}
+	}
+
+	vector->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(vector);
+
+	return _vector_at(vector, vector->size - 1);
+}
+
+void* vector_emplace_at(vector_t* vector, int n)
+{
+	if (n < 0 || (size_t)n > vector->size) return NULL;
+
+	if (n == 0) return _vector_push_front_slot(vector);
+
+	if (_vector_grow_check(vector)) {
+		if (!_vector_grow(vector)) {
+			return NULL;
+		}
+	}
+
+	_vector_shift_right(vector, n);
+
+	vector->size++;
+	STDCONTAINERS_STATS_MAX_SIZE(vector);
+
+	return _vector_at(vector, n);
+}
+
 int vector_assign(vector_t* vector, int n, const void* data)
 {
 	_vector_assign(vector, n, data);
@@ -231,6 +1090,16 @@ int vector_pop_back(vector_t* vector, void* data)
 }
 
 
+void* vector_pop_back_ptr(vector_t* vector)
+{
+	if (vector->size == 0) return NULL;
+
+	vector->size--;
+
+	return _vector_at(vector, vector->size);
+}
+
+
 int vector_pop_front(vector_t* vector, void* data)
 {
 	if (vector->size == 0) return -1;
@@ -240,9 +1109,7 @@ int vector_pop_front(vector_t* vector, void* data)
 		_vector_assign_ptr(vector, data, vector->data);
 	}
 
-	_vector_shift_left(vector, 0);
-
-	vector->size--;
+	_vector_pop_front_slot(vector);
 
 	if (_vector_shrink_check(vector)) {
 		_vector_shrink(vector);
@@ -256,18 +1123,144 @@ int vector_erase(vector_t* vector, int n)
 {
 	if (vector->size == 0 || (size_t)n >= vector->size) return -1;
 
-	_vector_shift_left(vector, n);
+	if (n == 0) {
+		_vector_pop_front_slot(vector);
+	}
+	else {
+		_vector_shift_left(vector, n);
+		vector->size--;
+	}
 
-	vector->size--;
+	if (_vector_shrink_check(vector)) {
+		_vector_shrink(vector);
+	}
+
+	return 0;
+
+}
+
+
+int vector_erase_range(vector_t* vector, int first, int last)
+{
+	size_t count;
+
+	if (first < 0 || last < first || (size_t)last > vector->size) return -1;
+	if (first == last) return 0;
+
+	count = (size_t)(last - first);
+
+	if (first == 0) {
+		_vector_drop_front(vector, count);
+	}
+	else {
+		memmove(_vector_at(vector, first), _vector_at(vector, last), (vector->size - (size_t)last) * vector->size_type);
+		vector->size -= count;
+	}
 
 	if (_vector_shrink_check(vector)) {
 		_vector_shrink(vector);
 	}
 
 	return 0;
+}
 
+size_t vector_remove_if(vector_t* vector, int (*pred)(const void* data, void* ctx), void* ctx)
+{
+	size_t size_type = vector->size_type;
+	uint8_t* read = vector->data;
+	uint8_t* end = vector->data + vector->size * size_type;
+	uint8_t* run = NULL;
+	uint8_t* write;
+	size_t removed;
+
+	/* nothing moves until the first match */
+	while (read != end && !pred(read, ctx)) {
+		read += size_type;
+	}
+	if (read == end) return 0;
+
+	write = read;
+	for (read += size_type; read != end; read += size_type) {
+		if (pred(read, ctx)) {
+			/* a run of kept elements is moved in one go when it ends */
+			if (run) {
+				memmove(write, run, (size_t)(read - run));
+				write += read - run;
+				run = NULL;
+			}
+		}
+		else if (!run) {
+			run = read;
+		}
+	}
+	if (run) {
+		memmove(write, run, (size_t)(end - run));
+		write += end - run;
+	}
+
+	removed = (size_t)(end - write) / size_type;
+	vector->size -= removed;
+	if (vector->size == 0) {
+		_vector_compact(vector);
+	}
+	if (_vector_shrink_check(vector)) {
+		_vector_shrink(vector);
+	}
+
+	return removed;
 }
 
+size_t vector_unique(vector_t* vector, int (*comp)(const void*, const void*))
+{
+	size_t size_type = vector->size_type;
+	uint8_t* end = vector->data + vector->size * size_type;
+	uint8_t* run = NULL;
+	uint8_t* last;
+	uint8_t* read;
+	uint8_t* write;
+	size_t removed;
+
+	if (vector->size < 2) return 0;
+
+	comp = STDCONTAINERS_STATS_COMPARATOR(vector, comp);
+
+	/* last is the last element kept so far. Nothing moves until the first duplicate */
+	last = vector->data;
+	read = last + size_type;
+	while (read != end && comp(last, read) != 0) {
+		last = read;
+		read += size_type;
+	}
+	if (read == end) return 0;
+
+	write = read;
+	for (read += size_type; read != end; read += size_type) {
+		if (comp(last, read) == 0) {
+			if (run) {
+				memmove(write, run, (size_t)(read - run));
+				write += read - run;
+				run = NULL;
+				last = write - size_type;
+			}
+		}
+		else {
+			if (!run) run = read;
+			last = read;
+		}
+	}
+	if (run) {
+		memmove(write, run, (size_t)(end - run));
+		write += end - run;
+	}
+
+	removed = (size_t)(end - write) / size_type;
+	vector->size -= removed;
+	if (_vector_shrink_check(vector)) {
+		_vector_shrink(vector);
+	}
+
+	return removed;
+}
 
 void* vector_front(vector_t* vector)
 {
@@ -294,8 +1287,10 @@ void* vector_back(vector_t* vector)
 
 int vector_shrink_to_fit(vector_t* vector)
 {
-	if (vector->size && vector->size != vector->capacity) {
-		
+	if (vector->size && (vector->size != vector->capacity || vector->head)) {
+
+		_vector_compact(vector);
+		STDCONTAINERS_STATS_INC(vector, shrinks);
 		if (_vector_resize(vector, vector->size)) {
 			return 0;
 		}
@@ -305,4 +1300,27 @@ int vector_shrink_to_fit(vector_t* vector)
 	}
 	return -1;
 
-}
\ No newline at end of file
+}
+
+
+int vector_get_stats(const vector_t* vector, container_stats_t* stats)
+{
+#ifdef STDCONTAINERS_STATS
+	memcpy(stats, &vector->stats, sizeof(container_stats_t));
+	return 0;
+#else
+	(void)vector;
+	memset(stats, 0x00, sizeof(container_stats_t));
+	return -1;
+#endif
+}
+
+void vector_reset_stats(vector_t* vector)
+{
+#ifdef STDCONTAINERS_STATS
+	memset(&vector->stats, 0x00, sizeof(container_stats_t));
+	vector->stats.max_size = (uint64_t)vector->size;
+#else
+	(void)vector;
+#endif
+}
@@ -31,6 +31,8 @@ SOFTWARE.
 #define _VECTOR_H_
 
 #include <stdint.h>
+#include <stddef.h>
+#include "stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,12 +43,27 @@ typedef struct vector_t {
 	size_t capacity;
 	size_t size_type;
 	uint8_t* data;
+	size_t head; /* free slots allocated before data, left by pops and reserved for pushes at the front */
+#ifdef STDCONTAINERS_STATS
+	container_stats_t stats;
+#endif
 }vector_t;
 
 
 #define VECTOR_DEFAULT_INITIAL_SIZE 2
 #define VECTOR_MINIMUM_CAPACITY 2
 
+/* vector_stable_sort: shorter inputs are insertion sorted, and natural runs shorter than about this are extended */
+#define VECTOR_STABLE_SORT_MIN_MERGE 32
+/* vector_stable_sort: a run winning this many times in a row switches the merge to galloping */
+#define VECTOR_STABLE_SORT_MIN_GALLOP 7
+/* vector_stable_sort: depth of the run stack, enough for any size_t length */
+#define VECTOR_STABLE_SORT_MAX_RUNS 85
+/* vector_partial_sort: k up to size / VECTOR_PARTIAL_SORT_HEAP_RATIO goes through a bounded heap */
+#define VECTOR_PARTIAL_SORT_HEAP_RATIO 128
+/* vector_nth_element: ranges this short are finished with an insertion sort */
+#define VECTOR_SELECT_THRESHOLD 16
+
 /**
   * @brief initialize an empty vector with an initial capacity of VECTOR_DEFAULT_INITIAL_SIZE
   * @param      vector: pointer to the vector_t struct to be initialized
@@ -96,6 +113,57 @@ void vector_destroy(vector_t* vector);
  */
 int vector_sort(vector_t* vector, int (*comp)(const void*, const void*));
 
+/**
+ * @brief stable sort of the given vector: equal elements keep their relative order
+ * @param  vector: the vector to perform the operation on
+ * @param  comp: a standard comparator function
+ * @return 0: success
+ *         -1: failure to allocate the merge buffer. All elements are still there, in an unspecified order
+ * @note natural merge sort (TimSort): runs already in order, ascending or strictly descending,
+ * are detected and merged with galloping, so sorted, reversed or nearly sorted data take close
+ * to linear time. The merge buffer holds at most half the vector and is freed on return
+ * @see vector_stable_sort_with
+ */
+int vector_stable_sort(vector_t* vector, int (*comp)(const void*, const void*));
+
+/**
+ * @brief vector_stable_sort using a caller provided scratch vector as merge buffer
+ * @param  vector: the vector to perform the operation on
+ * @param  comp: a standard comparator function
+ * @param  scratch: a vector of the same size_type whose buffer is borrowed, and grown when needed.
+ *         Its elements are discarded. Reusing it across sorts saves an allocation per call
+ * @return 0: success
+ *         -1: failure
+ */
+int vector_stable_sort_with(vector_t* vector, int (*comp)(const void*, const void*), vector_t* scratch);
+
+/**
+ * @brief partially sort the vector so that the element at position n is the one that would be there
+ * if the whole vector was sorted. No element before n compares greater than it, and no element
+ * after n compares less than it
+ * @param  vector: the vector to perform the operation on
+ * @param  n: position of the element to select
+ * @param  comp: a standard comparator function
+ * @return 0: success
+ *         -1: n is out of range
+ * @note introselect: quick select with a median of three pivot, falling back to a heap select
+ * when partitioning degenerates. Linear time on average, never worse than O(nlogn)
+ */
+int vector_nth_element(vector_t* vector, int n, int (*comp)(const void*, const void*));
+
+/**
+ * @brief sort the k smallest elements of the vector into its first k positions. The order of
+ * the remaining elements is unspecified
+ * @param  vector: the vector to perform the operation on
+ * @param  k: number of elements to sort. The whole vector is sorted when k >= vector->size
+ * @param  comp: a standard comparator function
+ * @return 0: success
+ *         -1: k is negative
+ * @note for a small k the elements go through a bounded heap of k elements, in O(nlogk).
+ * Larger k select with vector_nth_element then sort the first k elements only
+ */
+int vector_partial_sort(vector_t* vector, int k, int (*comp)(const void*, const void*));
+
 /**
   * @brief add data to the end of the vector
   * @param		vector: the vector to perform the operation on
@@ -111,8 +179,9 @@ int vector_push_back(vector_t* vector, const void* data);
   * @param		data: reference to the vector's data type holding the value to be added
   * @return		0: success
   *				-1: failure
-  * @note inserting values at the beginning or at a random location requires
-  * shifting the entire underlying array.
+  * @note O(1) amortized: the slots in front of the first element are reused, and
+  * when there are none, a new head as large as the vector is opened in one move.
+  * Inserting at a random location still requires shifting the array.
   */
 int vector_push_front(vector_t* vector, const void* data);
 
@@ -137,6 +206,26 @@ int vector_insert(vector_t* vector, int n, const void* data);
   */
 int vector_assign(vector_t* vector, int n, const void* data);
 
+/**
+  * @brief add an uninitialized element to the end of the vector
+  * @param		vector: the vector to perform the operation on
+  * @return		void*: pointer to the new element, to be filled in place by the caller
+  *				NULL: failure
+  * @note saves building the element in a temporary that vector_push_back would copy.
+  * The pointer is invalidated by the next operation that may reallocate the vector.
+  */
+void* vector_emplace_back(vector_t* vector);
+
+/**
+  * @brief add an uninitialized element at the specified index
+  * @param		vector: the vector to perform the operation on
+  * @param		n: the 0 indexed position of the new element. vector->size appends it
+  * @return		void*: pointer to the new element, to be filled in place by the caller
+  *				NULL: failure
+  * @note data after the specified index will be shifted right
+  */
+void* vector_emplace_at(vector_t* vector, int n);
+
 /**
   * @brief remove the last value of the given vector
   * data is optional. A NULL value is acceptable.
@@ -147,6 +236,16 @@ int vector_assign(vector_t* vector, int n, const void* data);
   */
 int vector_pop_back(vector_t* vector, void* data);
 
+/**
+  * @brief remove the last value of the given vector without copying it
+  * @param		vector: the vector to perform the operation on
+  * @return		void*: pointer to the removed value, still readable in place
+  *				NULL: the vector is empty
+  * @note the value stays valid until the next operation writing to the vector. Unlike
+  * vector_pop_back, the vector is never shrunk here so that the pointer cannot dangle.
+  */
+void* vector_pop_back_ptr(vector_t* vector);
+
 /**
   * @brief remove the first value of the given vector
   * data is optional. A NULL value is acceptable.
@@ -154,7 +253,8 @@ int vector_pop_back(vector_t* vector, void* data);
   * @param		data: reference to the list's data type where the poped value will be copied
   * @return		0: success
   *				-1: failure
-  * @note the entire underlying array will be shifted left. vector_pop_front can be a costly operation.
+  * @note O(1): the array is not shifted, the freed slot is kept in front of the first element
+  * and reused by vector_push_front or given back to the end of the buffer when it runs out of room.
   */
 int vector_pop_front(vector_t* vector, void* data);
 
@@ -164,10 +264,43 @@ int vector_pop_front(vector_t* vector, void* data);
   * @param		n: the 0 indexed n th value
   * @return		0: success
   *				-1: failure
-  * @note the elements after the specified index will be shifted left. vector_erase can be a costly operation.
+  * @note the elements after the specified index will be shifted left. vector_erase can be a costly operation,
+  * except for n = 0 which is a vector_pop_front.
   */
 int vector_erase(vector_t* vector, int n);
 
+/**
+  * @brief remove the elements in the range [first, last)
+  * @param		vector: the vector to perform the operation on
+  * @param		first: the 0 indexed first element to remove
+  * @param		last: the 0 indexed element following the last one to remove
+  * @return		0: success
+  *				-1: failure, invalid range
+  * @note the elements after the range are shifted left once, whatever the size of the range.
+  * A range starting at 0 is O(1), see vector_pop_front
+  */
+int vector_erase_range(vector_t* vector, int first, int last);
+
+/**
+  * @brief remove all elements for which pred returns non zero, keeping the order of the others
+  * @param		vector: the vector to perform the operation on
+  * @param		pred: predicate called once per element, in order, with the user context
+  * @param		ctx: user context passed to pred. Can be NULL
+  * @return		the number of elements removed
+  * @note single pass: every run of kept elements is moved at most once, and the vector is shrunk
+  * at most once. Repeated calls to vector_erase would be quadratic.
+  */
+size_t vector_remove_if(vector_t* vector, int (*pred)(const void* data, void* ctx), void* ctx);
+
+/**
+  * @brief remove consecutive duplicates, keeping the first element of every group of equal elements
+  * @param		vector: the vector to perform the operation on. Typically a sorted vector
+  * @param		comp: a standard comparator function. Elements are equal when it returns 0
+  * @return		the number of elements removed
+  * @note single pass, see vector_remove_if
+  */
+size_t vector_unique(vector_t* vector, int (*comp)(const void*, const void*));
+
 /**
   * @brief change the vector's capacity to match the exact number of elements it contains
   * @param		vector: the vector to perform the operation on
@@ -201,6 +334,22 @@ void* vector_back(vector_t* vector);
   */
 void* vector_at(vector_t* vector, int n);
 
+/**
+  * @brief copy the counters recorded by the vector since its creation or the last vector_reset_stats
+  * @param		vector: the vector to perform the operation on
+  * @param		stats: where the counters are copied
+  * @return		0: success
+  *				-1: the library was compiled without STDCONTAINERS_STATS. stats is zero filled
+  * @see stats.h
+  */
+int vector_get_stats(const vector_t* vector, container_stats_t* stats);
+
+/**
+  * @brief reset the vector's counters. max_size restarts from the current size
+  * @param		vector: the vector to perform the operation on
+  */
+void vector_reset_stats(vector_t* vector);
+
 
 
 #ifdef __cplusplus
@@ -0,0 +1,250 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file work_stealing_deque.c
+@author Tony Pottier
+@brief Source code for the Chase-Lev work-stealing deque
+
+top and bottom are ever increasing indices, the task at index i lives in
+slot i & mask of the current array. The deque holds the tasks in [top, bottom).
+
+A thief copies the task into a local buffer before its compare-and-swap on
+top: once top is incremented, the owner is free to overwrite the slot. If the
+owner did overwrite it in the meantime, the compare-and-swap fails and the
+copy is discarded. The caller's buffer is only written once the task is won.
+Owner writes and thief reads of a slot go through relaxed atomic accesses, so
+such an overlap is not a data race.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "work_stealing_deque.h"
+
+
+static work_stealing_deque_array_t* _work_stealing_deque_array_create(int64_t capacity, size_t size_type)
+{
+	work_stealing_deque_array_t* array = (work_stealing_deque_array_t*)malloc(sizeof(work_stealing_deque_array_t));
+
+	if (!array) return NULL;
+
+	array->data = (uint8_t*)malloc((size_t)capacity * size_type);
+	if (!array->data) {
+		free(array);
+		return NULL;
+	}
+	array->mask = capacity - 1;
+	array->retired = NULL;
+
+	return array;
+}
+
+static inline uint8_t* _work_stealing_deque_slot(work_stealing_deque_array_t* array, int64_t i, size_t size_type)
+{
+	return array->data + (size_t)(i & array->mask) * size_type;
+}
+
+/**
+ * @brief write a task to a slot a thief may be reading, 8 bytes at a time when the slot is aligned
+ */
+static inline void _work_stealing_deque_slot_store(uint8_t* slot, const void* data, size_t size_type)
+{
+	const uint8_t* in = (const uint8_t*)data;
+	uint64_t word;
+	size_t i = 0;
+
+	if (((uintptr_t)slot & (sizeof(uint64_t) - 1)) == 0) {
+		for (; i + sizeof(uint64_t) <= size_type; i += sizeof(uint64_t)) {
+			memcpy(&word, in + i, sizeof(uint64_t));
+			__atomic_store_n((uint64_t*)(slot + i), word, __ATOMIC_RELAXED);
+		}
+	}
+	for (; i < size_type; i++) {
+		__atomic_store_n(slot + i, in[i], __ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * @brief read a task from a slot the owner may be writing, with the same access sizes as _work_stealing_deque_slot_store
+ */
+static inline void _work_stealing_deque_slot_load(void* data, const uint8_t* slot, size_t size_type)
+{
+	uint8_t* out = (uint8_t*)data;
+	uint64_t word;
+	size_t i = 0;
+
+	if (((uintptr_t)slot & (sizeof(uint64_t) - 1)) == 0) {
+		for (; i + sizeof(uint64_t) <= size_type; i += sizeof(uint64_t)) {
+			word = __atomic_load_n((const uint64_t*)(slot + i), __ATOMIC_RELAXED);
+			memcpy(out + i, &word, sizeof(uint64_t));
+		}
+	}
+	for (; i < size_type; i++) {
+		out[i] = __atomic_load_n(slot + i, __ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * @brief replace the array with one twice as large holding the tasks in [top, bottom).
+ * The old array is kept: thieves may still be reading from it.
+ */
+static work_stealing_deque_array_t* _work_stealing_deque_grow(work_stealing_deque_t* deque, work_stealing_deque_array_t* array, int64_t top, int64_t bottom)
+{
+	work_stealing_deque_array_t* bigger = _work_stealing_deque_array_create((array->mask + 1) << 1, deque->size_type);
+	int64_t i;
+
+	if (!bigger) return NULL;
+
+	for (i = top; i < bottom; i++) {
+		memcpy(_work_stealing_deque_slot(bigger, i, deque->size_type), _work_stealing_deque_slot(array, i, deque->size_type), deque->size_type);
+	}
+	bigger->retired = array;
+
+	__atomic_store_n(&deque->array, bigger, __ATOMIC_RELEASE);
+
+	return bigger;
+}
+
+
+int work_stealing_deque_create(work_stealing_deque_t* deque, size_t size_type)
+{
+	return work_stealing_deque_create_with(deque, size_type, WORK_STEALING_DEQUE_DEFAULT_CAPACITY);
+}
+
+int work_stealing_deque_create_with(work_stealing_deque_t* deque, size_t size_type, size_t capacity)
+{
+	int64_t rounded = 1;
+
+	if (!deque || size_type == 0 || size_type > WORK_STEALING_DEQUE_MAX_TASK_SIZE || capacity > ((size_t)1 << 32)) return -1;
+
+	while ((size_t)rounded < capacity) {
+		rounded <<= 1;
+	}
+
+	memset(deque, 0x00, sizeof(work_stealing_deque_t));
+	deque->size_type = size_type;
+	deque->array = _work_stealing_deque_array_create(rounded, size_type);
+
+	return deque->array ? 0 : -1;
+}
+
+void work_stealing_deque_destroy(work_stealing_deque_t* deque)
+{
+	work_stealing_deque_array_t* array = deque->array;
+	work_stealing_deque_array_t* retired;
+
+	while (array != NULL) {
+		retired = array->retired;
+		free(array->data);
+		free(array);
+		array = retired;
+	}
+
+	memset(deque, 0x00, sizeof(work_stealing_deque_t));
+}
+
+int work_stealing_deque_push(work_stealing_deque_t* deque, const void* data)
+{
+	int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+	int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+	work_stealing_deque_array_t* array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+
+	if (bottom - top > array->mask) {
+		array = _work_stealing_deque_grow(deque, array, top, bottom);
+		if (!array) return -1;
+	}
+
+	_work_stealing_deque_slot_store(_work_stealing_deque_slot(array, bottom, deque->size_type), data, deque->size_type);
+
+	/* the task must be visible before thieves can see the new bottom */
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+
+	return 0;
+}
+
+int work_stealing_deque_pop(work_stealing_deque_t* deque, void* data)
+{
+	int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+	work_stealing_deque_array_t* array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+	int64_t top;
+	int ret = 0;
+
+	/* claim the bottom task first, then look at what thieves did */
+	__atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+	if (top <= bottom) {
+		if (top == bottom) {
+			/* last task: race thieves for it */
+			if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+				ret = -1;
+			}
+			__atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+		}
+		/* only the owner writes slots: the task won is still in place after the compare-and-swap */
+		if (ret == 0) {
+			memcpy(data, _work_stealing_deque_slot(array, bottom, deque->size_type), deque->size_type);
+		}
+	}
+	else {
+		ret = -1;
+		__atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+	}
+
+	return ret;
+}
+
+int work_stealing_deque_steal(work_stealing_deque_t* deque, void* data)
+{
+	int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+	int64_t bottom;
+	work_stealing_deque_array_t* array;
+	uint64_t task[WORK_STEALING_DEQUE_MAX_TASK_SIZE / sizeof(uint64_t)];
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+
+	if (top >= bottom) return WORK_STEALING_DEQUE_EMPTY;
+
+	array = __atomic_load_n(&deque->array, __ATOMIC_ACQUIRE);
+	_work_stealing_deque_slot_load(task, _work_stealing_deque_slot(array, top, deque->size_type), deque->size_type);
+
+	if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+		return WORK_STEALING_DEQUE_ABORT;
+	}
+
+	memcpy(data, task, deque->size_type);
+
+	return 0;
+}
+
+size_t work_stealing_deque_size(work_stealing_deque_t* deque)
+{
+	int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+	int64_t top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+	return bottom > top ? (size_t)(bottom - top) : 0;
+}
@@ -0,0 +1,151 @@
+/**
+Copyright (c) 2020 Tony Pottier
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+@file work_stealing_deque.h
+@author Tony Pottier
+@brief Chase-Lev work-stealing deque for task schedulers
+
+A work-stealing deque belongs to one thread, its owner, which pushes and pops
+tasks at the bottom end like a stack. Any other thread can steal tasks from
+the top end. Owner operations only need plain loads and stores on the fast
+path: a compare-and-swap is only needed to take the very last task, when the
+owner may race with a thief. Thieves always compare-and-swap the top index.
+
+Tasks are size_type bytes copied in a circular array which grows (doubling)
+when full. Thieves may still be reading an old array while it is replaced, so
+retired arrays are kept until the deque is destroyed. Their total size is
+bounded by the size of the current array.
+
+The algorithm is the one of "Dynamic Circular Work-Stealing Deque", Chase and
+Lev, SPAA 2005, with the C11 memory orderings of "Correct and Efficient
+Work-Stealing for Weak Memory Models", Le et al., PPoPP 2013.
+
+Requires GCC or clang __atomic builtins.
+
+@see https://github.com/tonyp7/stdcontainers
+
+*/
+
+#ifndef _WORK_STEALING_DEQUE_H_
+#define _WORK_STEALING_DEQUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WORK_STEALING_DEQUE_DEFAULT_CAPACITY 64
+
+/* largest task, in bytes: a thief copies the task it steals to a buffer of this size on its stack */
+#define WORK_STEALING_DEQUE_MAX_TASK_SIZE 256
+
+/* return codes of work_stealing_deque_steal */
+#define WORK_STEALING_DEQUE_EMPTY -1
+#define WORK_STEALING_DEQUE_ABORT -2
+
+#define WORK_STEALING_DEQUE_CACHE_LINE 64
+
+typedef struct work_stealing_deque_array_t {
+	struct work_stealing_deque_array_t* retired;	/* previous, smaller array */
+	int64_t mask;
+	uint8_t* data;
+}work_stealing_deque_array_t;
+
+typedef struct work_stealing_deque_t {
+	/* top is written by thieves, bottom by the owner: keep them on different cache lines */
+	int64_t top;
+	uint8_t _padding0[WORK_STEALING_DEQUE_CACHE_LINE - sizeof(int64_t)];
+	int64_t bottom;
+	uint8_t _padding1[WORK_STEALING_DEQUE_CACHE_LINE - sizeof(int64_t)];
+	work_stealing_deque_array_t* array;
+	size_t size_type;
+}work_stealing_deque_t;
+
+
+/**
+  * @brief initialize an empty deque with an initial capacity of WORK_STEALING_DEQUE_DEFAULT_CAPACITY
+  * @param      deque: pointer to the work_stealing_deque_t struct to be initialized
+  * @param		size_type: size in bytes of the tasks to be stored, at most WORK_STEALING_DEQUE_MAX_TASK_SIZE
+  * @return		0: success
+  *				-1: failure
+  */
+int work_stealing_deque_create(work_stealing_deque_t* deque, size_t size_type);
+
+/**
+  * @brief initialize an empty deque with the given initial capacity
+  * @param      deque: pointer to the work_stealing_deque_t struct to be initialized
+  * @param		size_type: size in bytes of the tasks to be stored, at most WORK_STEALING_DEQUE_MAX_TASK_SIZE
+  * @param		capacity: initial capacity, rounded up to a power of two
+  * @return		0: success
+  *				-1: failure
+  */
+int work_stealing_deque_create_with(work_stealing_deque_t* deque, size_t size_type, size_t capacity);
+
+/**
+  * @brief free the deque and all its arrays. No other thread may be using the deque.
+  * @param  deque: the deque to perform the operation on
+  */
+void work_stealing_deque_destroy(work_stealing_deque_t* deque);
+
+/**
+  * @brief push a task at the bottom of the deque. Owner only.
+  * @param  deque: the deque to perform the operation on
+  * @param  data: reference to the task to push
+  * @return 0: success
+  *         -1: failure to grow the deque
+  */
+int work_stealing_deque_push(work_stealing_deque_t* deque, const void* data);
+
+/**
+  * @brief pop the task at the bottom of the deque, i.e. the most recently pushed one. Owner only.
+  * @param  deque: the deque to perform the operation on
+  * @param  data: receives a copy of the task. It is left untouched when the pop fails
+  * @return 0: success
+  *         -1: the deque is empty
+  */
+int work_stealing_deque_pop(work_stealing_deque_t* deque, void* data);
+
+/**
+  * @brief steal the task at the top of the deque, i.e. the oldest one. Can be called by any thread.
+  * @param  deque: the deque to perform the operation on
+  * @param  data: receives a copy of the task. It is left untouched when the steal fails
+  * @return 0: success
+  *         WORK_STEALING_DEQUE_EMPTY: the deque is empty
+  *         WORK_STEALING_DEQUE_ABORT: lost the race against the owner or another thief, the deque
+  *         may still have tasks
+  */
+int work_stealing_deque_steal(work_stealing_deque_t* deque, void* data);
+
+/**
+  * @brief number of tasks in the deque. The value may be outdated as soon as it is returned.
+  */
+size_t work_stealing_deque_size(work_stealing_deque_t* deque);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif